@@ -19,9 +19,20 @@
 
 // Debugging
 #define CONFIG_ENABLE_DEBUG             1
+#ifdef PLATFORM_SIM
+#define CONFIG_ENABLE_PROFILER          1
+#else
 #define CONFIG_ENABLE_PROFILER          0
+#endif
 #define CONFIG_ENABLE_TASK_PROFILER     1
 
+// Profiler (number of recorded events, power of two)
+#ifdef PLATFORM_SIM
+#define CONFIG_PROFILER_EVENT_COUNT     65536
+#else
+#define CONFIG_PROFILER_EVENT_COUNT     256
+#endif
+
 // Sanitization
 #define CONFIG_ENABLE_SANITIZE          1
 
@@ -58,6 +58,9 @@
 #define CONFIG_USER_SCALE_COUNT         4
 #define CONFIG_USER_SCALE_SIZE          32
 
+// Engine
+#define CONFIG_EVENT_QUEUE_SIZE         32
+
 
 #define CONFIG_ENABLE_ASTEROIDS
 // #define CONFIG_ENABLE_INTRO
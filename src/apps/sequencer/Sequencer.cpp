@@ -66,12 +66,13 @@ static UsbH usbh(usbMidi);
 static SdCard sdCard;
 
 static fs::Volume volume(sdCard);
+static FileManager fileManager(&volume);
 
 static CCMRAM_BSS Profiler profiler;
 
 static Model model;
 static CCMRAM_BSS Engine engine(model, clockTimer, adc, dac, dio, gateOutput, midi, usbMidi);
-static CCMRAM_BSS Ui ui(model, engine, lcd, blm, encoder);
+static CCMRAM_BSS Ui ui(model, engine, fileManager, lcd, blm, encoder);
 
 
 static constexpr uint32_t TaskAliveCount = 4;
@@ -110,7 +111,7 @@ static CCMRAM_BSS os::PeriodicTask<CONFIG_UI_TASK_STACK_SIZE> uiTask("ui", CONFI
 });
 
 static os::PeriodicTask<CONFIG_FILE_TASK_STACK_SIZE> fsTask("file", CONFIG_FILE_TASK_PRIORITY, os::time::ms(10), [] () {
-    FileManager::processTask();
+    fileManager.processTask();
     // no task alive handling because processTask() can take a long time to complete
 });
 
@@ -118,6 +119,7 @@ static os::PeriodicTask<CONFIG_FILE_TASK_STACK_SIZE> fsTask("file", CONFIG_FILE_
 static CCMRAM_BSS os::PeriodicTask<CONFIG_PROFILER_TASK_STACK_SIZE> profilerTask("profiler", 0, os::time::ms(5000), [&] () {
 #if CONFIG_ENABLE_PROFILER
     profiler.dump();
+    profiler.dumpEvents();
 #endif // CONFIG_ENABLE_PROFILE
 #if CONFIG_ENABLE_TASK_PROFILER
     os::TaskProfiler::dump();
@@ -148,6 +150,10 @@ int main(void) {
     dbg_set_assert_handler(&assert_handler);
 
     profiler.init();
+#if CONFIG_ENABLE_PROFILER
+    // the profiler is only compiled into the target on request, record right away
+    Profiler::setEnabled(true);
+#endif
 
     shiftRegister.init();
     clockTimer.init();
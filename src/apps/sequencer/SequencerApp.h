@@ -20,10 +20,38 @@
 #include "ui/Ui.h"
 
 #include "os/os.h"
+#include "sim/Simulator.h"
 
-static os::PeriodicTask<1024> fsTask("file", CONFIG_FILE_TASK_PRIORITY, os::time::ms(10), [] () {
-    FileManager::processTask();
-});
+#include <atomic>
+#include <memory>
+
+// FatFs only supports a single volume per process.
+// When running multiple simulators, only one at a time gets access to the sd card.
+class SharedVolume {
+public:
+    SharedVolume(SdCard &sdCard) {
+        if (!claimed().exchange(true)) {
+            _volume.reset(new fs::Volume(sdCard));
+        }
+    }
+
+    ~SharedVolume() {
+        if (_volume) {
+            _volume.reset();
+            claimed() = false;
+        }
+    }
+
+    fs::Volume *get() { return _volume.get(); }
+
+private:
+    static std::atomic<bool> &claimed() {
+        static std::atomic<bool> claimed(false);
+        return claimed;
+    }
+
+    std::unique_ptr<fs::Volume> _volume;
+};
 
 struct SequencerApp {
     // drivers
@@ -40,27 +68,57 @@ struct SequencerApp {
     SdCard sdCard;
 
     // filesystem
-    fs::Volume volume;
+    SharedVolume volume;
+    FileManager fileManager;
 
     // application
     Model model;
     Engine engine;
     Ui ui;
 
-    SequencerApp() :
+    // tasks
+    os::PeriodicTask<1024> fsTask;
+    std::unique_ptr<os::PeriodicTask<CONFIG_ENGINE_TASK_STACK_SIZE>> engineTask;
+    std::unique_ptr<os::PeriodicTask<CONFIG_UI_TASK_STACK_SIZE>> uiTask;
+
+    SequencerApp(sim::Simulator &simulator) :
+        clockTimer(simulator),
+        blm(simulator),
+        lcd(simulator),
+        adc(simulator),
+        dac(simulator),
+        dio(simulator),
+        encoder(simulator),
+        gateOutput(simulator),
+        midi(simulator),
+        usbMidi(simulator),
         volume(sdCard),
+        fileManager(volume.get()),
         engine(model, clockTimer, adc, dac, dio, gateOutput, midi, usbMidi),
-        ui(model, engine, lcd, blm, encoder)
+        ui(model, engine, fileManager, lcd, blm, encoder),
+        fsTask("file", CONFIG_FILE_TASK_PRIORITY, os::time::ms(10), [this] () {
+            fileManager.processTask();
+        })
     {
-        FileManager::init();
-
         model.init();
         engine.init();
         ui.init();
+
+        // run engine and ui as prioritized tasks like on the hardware
+        if (simulator.threadedTasks()) {
+            engineTask.reset(new os::PeriodicTask<CONFIG_ENGINE_TASK_STACK_SIZE>("engine", CONFIG_ENGINE_TASK_PRIORITY, os::time::ms(1), [this] () {
+                engine.update();
+            }));
+            uiTask.reset(new os::PeriodicTask<CONFIG_UI_TASK_STACK_SIZE>("ui", CONFIG_UI_TASK_PRIORITY, os::time::ms(1), [this] () {
+                ui.update();
+            }));
+        }
     }
 
     void update() {
-        engine.update();
-        ui.update();
+        if (!engineTask) {
+            engine.update();
+            ui.update();
+        }
     }
 };
@@ -10,7 +10,7 @@ int main(int argc, char *argv[]) {
 
     sim::Simulator sim({
         .create = [&] () {
-            app.reset(new SequencerApp());
+            app.reset(new SequencerApp(sim));
         },
         .destroy = [&] () {
             app.reset();
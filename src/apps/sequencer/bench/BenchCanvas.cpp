@@ -0,0 +1,226 @@
+// Canvas rendering benchmark
+//
+// Runs the sequencer headless on the simulator and renders the most drawing
+// intensive pages into a separate frame buffer while the sequencer is playing.
+// Frames alternate between drawing with and without the text cache, so both are
+// measured under the same conditions.
+// Reports the time spent in drawing per frame for each page as machine-readable JSON.
+//
+// Usage: bench_canvas [frames] [report.json]
+
+#include "SequencerApp.h"
+
+#include "ui/Key.h"
+#include "ui/MessageManager.h"
+#include "ui/PageManager.h"
+#include "ui/pages/Pages.h"
+
+#include "core/gfx/Canvas.h"
+#include "core/gfx/FrameBuffer.h"
+#include "core/gfx/TextCache.h"
+
+#include "sim/Simulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+typedef std::chrono::steady_clock BenchClock;
+
+// UI state for rendering pages independent of the application UI
+struct BenchUi {
+    MessageManager messageManager;
+    KeyState pageKeyState;
+    KeyState globalKeyState;
+    PageManager pageManager;
+    PageContext pageContext;
+    Pages pages;
+
+    BenchUi(SequencerApp &app) :
+        pageManager(pages),
+        pageContext({ messageManager, pageKeyState, globalKeyState, app.model, app.engine, app.fileManager }),
+        pages(pageManager, pageContext)
+    {}
+};
+
+struct BenchPage {
+    const char *name;
+    int trackIndex;
+    Page *page;
+};
+
+// fills the first two tracks with content that exercises most of the drawing code
+static void setupProject(Project &project) {
+    auto &noteSequence = project.noteSequence(0, 0);
+    for (int stepIndex = 0; stepIndex < CONFIG_STEP_COUNT; ++stepIndex) {
+        auto &step = noteSequence.step(stepIndex);
+        step.setGate(true);
+        step.setNote(stepIndex % 12);
+        step.setLength(stepIndex % 8);
+        step.setSlide(stepIndex % 3 == 0);
+        step.setRetrigger(stepIndex % 4);
+    }
+
+    project.setTrackMode(1, Track::TrackMode::Curve);
+    auto &curveSequence = project.curveSequence(1, 0);
+    for (int stepIndex = 0; stepIndex < CONFIG_STEP_COUNT; ++stepIndex) {
+        auto &step = curveSequence.step(stepIndex);
+        step.setShape(stepIndex % Curve::Last);
+        step.setMinNormalized((stepIndex % 4) * 0.1f);
+        step.setMaxNormalized(1.f - (stepIndex % 3) * 0.1f);
+    }
+
+    auto &song = project.song();
+    for (int slotIndex = 0; slotIndex < 16; ++slotIndex) {
+        song.chainPattern(slotIndex % 4);
+    }
+}
+
+static void writeSamples(FILE *file, std::vector<uint32_t> &ns) {
+    std::sort(ns.begin(), ns.end());
+    double total = 0.0;
+    for (auto value : ns) {
+        total += value;
+    }
+    auto percentile = [&] (double p) {
+        return ns.empty() ? 0u : ns[size_t(std::round(p * (ns.size() - 1)))];
+    };
+    std::fprintf(file,
+        "{ \"frames\": %zu, \"mean_us\": %.2f, \"p50_us\": %.2f, \"p99_us\": %.2f, \"max_us\": %.2f }",
+        ns.size(), ns.empty() ? 0.0 : total / ns.size() * 1e-3, percentile(0.5) * 1e-3, percentile(0.99) * 1e-3, percentile(1.0) * 1e-3
+    );
+}
+
+int main(int argc, char *argv[]) {
+    int frames = argc > 1 ? std::atoi(argv[1]) : 1000;
+    const char *reportPath = argc > 2 ? argv[2] : nullptr;
+
+    if (frames <= 0) {
+        std::fprintf(stderr, "usage: %s [frames] [report.json]\n", argv[0]);
+        return 1;
+    }
+
+    FILE *file = reportPath ? std::fopen(reportPath, "w") : stdout;
+    if (!file) {
+        std::fprintf(stderr, "failed to open '%s'\n", reportPath);
+        return 1;
+    }
+
+    std::unique_ptr<SequencerApp> app;
+    std::unique_ptr<BenchUi> ui;
+
+    static uint8_t frameBufferData[CONFIG_LCD_WIDTH * CONFIG_LCD_HEIGHT / 2];
+    FrameBuffer4bit frameBuffer(CONFIG_LCD_WIDTH, CONFIG_LCD_HEIGHT, frameBufferData);
+    Canvas canvas(frameBuffer);
+    TextCache textCache;
+
+    // pages are rendered from the update callback to run in the simulator context
+    const int FrameInterval = 1000 / CONFIG_DEFAULT_UI_FPS;
+    Page *pendingPage = nullptr;
+    // samples with and without text cache
+    std::vector<uint32_t> *samples = nullptr;
+    int updates = 0;
+    int drawnFrames = 0;
+
+    sim::Simulator simulator(sim::Target {
+        // create
+        [&] () {
+            app.reset(new SequencerApp(sim::Simulator::current()));
+            ui.reset(new BenchUi(*app));
+        },
+        // destroy
+        [&] () {
+            ui.reset();
+            app.reset();
+        },
+        // update
+        [&] () {
+            app->update();
+
+            if (pendingPage) {
+                ui->pageManager.reset(pendingPage);
+                pendingPage = nullptr;
+            }
+            if (samples && ++updates % FrameInterval == 0) {
+                int mode = drawnFrames++ % 2;
+                canvas.setTextCache(mode == 0 ? &textCache : nullptr);
+                if (mode == 0) {
+                    textCache.nextFrame();
+                }
+                auto start = BenchClock::now();
+                ui->pageManager.draw(canvas);
+                samples[mode].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - start).count());
+            }
+        }
+    });
+
+    // wait for the startup page to finish
+    simulator.wait(3000);
+
+    auto &project = app->model.project();
+    setupProject(project);
+
+    const BenchPage pages[] = {
+        { "note_sequence_edit", 0, &ui->pages.noteSequenceEdit },
+        { "curve_sequence_edit", 1, &ui->pages.curveSequenceEdit },
+        { "song", 0, &ui->pages.song },
+        { "project", 0, &ui->pages.project },
+        { "track", 0, &ui->pages.track },
+        { "clock_setup", 0, &ui->pages.clockSetup },
+        { "monitor", 0, &ui->pages.monitor },
+    };
+    const int pageCount = sizeof(pages) / sizeof(pages[0]);
+
+    app->engine.clockStart();
+
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"benchmark\": \"canvas\",\n");
+    std::fprintf(file, "  \"pages\": {\n");
+
+    std::vector<uint32_t> totalNs[2];
+
+    for (int i = 0; i < pageCount; ++i) {
+        const auto &page = pages[i];
+        project.setSelectedTrackIndex(page.trackIndex);
+        pendingPage = page.page;
+
+        std::vector<uint32_t> ns[2];
+        textCache.clear();
+        drawnFrames = 0;
+        samples = ns;
+        simulator.wait(2 * frames * FrameInterval);
+        samples = nullptr;
+
+        std::fprintf(file, "    \"%s\": {\n", page.name);
+        for (int mode = 0; mode < 2; ++mode) {
+            totalNs[mode].insert(totalNs[mode].end(), ns[mode].begin(), ns[mode].end());
+            std::fprintf(file, "      \"%s\": ", mode == 0 ? "text_cache" : "no_text_cache");
+            writeSamples(file, ns[mode]);
+            std::fprintf(file, mode == 0 ? ",\n" : "\n");
+        }
+        std::fprintf(file, "    },\n");
+    }
+
+    std::fprintf(file, "    \"total\": {\n");
+    std::fprintf(file, "      \"text_cache\": ");
+    writeSamples(file, totalNs[0]);
+    std::fprintf(file, ",\n");
+    std::fprintf(file, "      \"no_text_cache\": ");
+    writeSamples(file, totalNs[1]);
+    std::fprintf(file, "\n");
+    std::fprintf(file, "    }\n");
+
+    std::fprintf(file, "  }\n");
+    std::fprintf(file, "}\n");
+
+    if (file != stdout) {
+        std::fclose(file);
+    }
+
+    return 0;
+}
@@ -0,0 +1,378 @@
+// Engine micro-benchmark
+//
+// Runs the engine headless on the simulator with synthetic worst-case
+// projects and reports the cost of Engine::update() and TrackEngine::tick()
+// together with the clock and gate output timing histograms as machine-readable JSON.
+//
+// Usage: bench_engine [duration-ms] [report.json] [update-interval-us]
+
+#include "Config.h"
+
+#include "drivers/Adc.h"
+#include "drivers/ClockTimer.h"
+#include "drivers/Dac.h"
+#include "drivers/Dio.h"
+#include "drivers/GateOutput.h"
+#include "drivers/Midi.h"
+#include "drivers/UsbMidi.h"
+
+#include "model/Model.h"
+#include "engine/Engine.h"
+
+#include "sim/Simulator.h"
+
+#include "core/midi/MidiMessage.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+typedef std::chrono::steady_clock BenchClock;
+
+struct BenchTarget {
+    ClockTimer clockTimer;
+    Adc adc;
+    Dac dac;
+    Dio dio;
+    GateOutput gateOutput;
+    Midi midi;
+    UsbMidi usbMidi;
+
+    Model model;
+    Engine engine;
+
+    BenchTarget(sim::Simulator &simulator) :
+        clockTimer(simulator),
+        adc(simulator),
+        dac(simulator),
+        dio(simulator),
+        gateOutput(simulator),
+        midi(simulator),
+        usbMidi(simulator),
+        engine(model, clockTimer, adc, dac, dio, gateOutput, midi, usbMidi)
+    {
+        model.init();
+        engine.init();
+    }
+};
+
+class Samples {
+public:
+    void add(uint32_t ns) { _ns.push_back(ns); }
+
+    void write(FILE *file, const char *name) {
+        std::sort(_ns.begin(), _ns.end());
+        double total = 0.0;
+        for (auto ns : _ns) {
+            total += ns;
+        }
+        std::fprintf(file,
+            "\"%s\": { \"calls\": %zu, \"mean_ns\": %.1f, \"p50_ns\": %u, \"p99_ns\": %u, \"max_ns\": %u }",
+            name, _ns.size(), _ns.empty() ? 0.0 : total / _ns.size(), percentile(0.5), percentile(0.99), percentile(1.0)
+        );
+    }
+
+private:
+    uint32_t percentile(double p) const {
+        if (_ns.empty()) {
+            return 0;
+        }
+        return _ns[size_t(std::round(p * (_ns.size() - 1)))];
+    }
+
+    std::vector<uint32_t> _ns;
+};
+
+static void writeHistogram(FILE *file, const char *name, const TimingHistogram &histogram) {
+    std::fprintf(file,
+        "\"%s\": { \"edges\": %u, \"mean_abs_us\": %u, \"min_us\": %d, \"max_us\": %d, \"buckets\": [",
+        name, histogram.count(), histogram.mean(), histogram.min(), histogram.max()
+    );
+    for (int i = 0; i < TimingHistogram::BucketCount; ++i) {
+        if (i < TimingHistogram::BucketCount - 1) {
+            std::fprintf(file, "%s{ \"lt_us\": %u, \"count\": %u }", i > 0 ? ", " : "", TimingHistogram::bucketLimit(i), histogram.bucket(i));
+        } else {
+            std::fprintf(file, ", { \"count\": %u }", histogram.bucket(i));
+        }
+    }
+    std::fprintf(file, "] }");
+}
+
+static uint32_t elapsedNs(BenchClock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - start).count();
+}
+
+//----------------------------------------
+// Scenarios
+//----------------------------------------
+
+// all 16 routes active on per-track targets of all tracks, fed from cv inputs and midi cc
+static void setupRoutes(Project &project) {
+    static const Routing::Target targets[CONFIG_ROUTE_COUNT] = {
+        Routing::Target::Swing,
+        Routing::Target::Fill,
+        Routing::Target::FillAmount,
+        Routing::Target::SlideTime,
+        Routing::Target::Octave,
+        Routing::Target::Transpose,
+        Routing::Target::Rotate,
+        Routing::Target::GateProbabilityBias,
+        Routing::Target::RetriggerProbabilityBias,
+        Routing::Target::LengthBias,
+        Routing::Target::NoteProbabilityBias,
+        Routing::Target::ShapeProbabilityBias,
+        Routing::Target::Divisor,
+        Routing::Target::RunMode,
+        Routing::Target::FirstStep,
+        Routing::Target::LastStep,
+    };
+
+    for (int routeIndex = 0; routeIndex < CONFIG_ROUTE_COUNT; ++routeIndex) {
+        auto &route = project.routing().route(routeIndex);
+        route.setTarget(targets[routeIndex]);
+        route.setTracks(0xff);
+        if (routeIndex % 2 == 0) {
+            route.setSource(Routing::Source(int(Routing::Source::CvIn1) + (routeIndex / 2) % 4));
+        } else {
+            route.setSource(Routing::Source::Midi);
+            route.midiSource().setEvent(Routing::MidiSource::Event::ControlAbsolute);
+            route.midiSource().setControlNumber(routeIndex);
+        }
+    }
+}
+
+// all 16 routes active on sequence targets of all tracks, cost used to scale with the pattern count
+static void setupSequenceRoutes(Project &project) {
+    static const Routing::Target targets[] = {
+        Routing::Target::Divisor,
+        Routing::Target::RunMode,
+        Routing::Target::FirstStep,
+        Routing::Target::LastStep,
+    };
+
+    for (int routeIndex = 0; routeIndex < CONFIG_ROUTE_COUNT; ++routeIndex) {
+        auto &route = project.routing().route(routeIndex);
+        route.setTarget(targets[routeIndex % 4]);
+        route.setTracks(0xff);
+        if (routeIndex % 2 == 0) {
+            route.setSource(Routing::Source(int(Routing::Source::CvIn1) + (routeIndex / 2) % 4));
+        } else {
+            route.setSource(Routing::Source::Midi);
+            route.midiSource().setEvent(Routing::MidiSource::Event::ControlAbsolute);
+            route.midiSource().setControlNumber(routeIndex);
+        }
+    }
+}
+
+static void setupNoteScenario(Project &project) {
+    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+        project.setTrackMode(trackIndex, Track::TrackMode::Note);
+        auto &sequence = project.noteSequence(trackIndex, 0);
+        sequence.setDivisor(1);
+        sequence.setFirstStep(0);
+        sequence.setLastStep(CONFIG_STEP_COUNT - 1);
+        for (int stepIndex = 0; stepIndex < CONFIG_STEP_COUNT; ++stepIndex) {
+            auto &step = sequence.step(stepIndex);
+            step.setGate(true);
+            step.setGateProbability(NoteSequence::GateProbability::Max);
+            step.setRetrigger(NoteSequence::Retrigger::Max);
+            step.setRetriggerProbability(NoteSequence::RetriggerProbability::Max);
+            step.setLength(NoteSequence::Length::Max);
+            step.setLengthVariationRange(NoteSequence::LengthVariationRange::Max);
+            step.setLengthVariationProbability(NoteSequence::LengthVariationProbability::Max);
+            step.setNote(stepIndex % 24);
+            step.setNoteVariationRange(12);
+            step.setNoteVariationProbability(NoteSequence::NoteVariationProbability::Max);
+            step.setSlide(stepIndex % 2);
+        }
+    }
+}
+
+static void setupCurveScenario(Project &project) {
+    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+        project.setTrackMode(trackIndex, Track::TrackMode::Curve);
+        auto &sequence = project.curveSequence(trackIndex, 0);
+        sequence.setDivisor(1);
+        sequence.setFirstStep(0);
+        sequence.setLastStep(CONFIG_STEP_COUNT - 1);
+        for (int stepIndex = 0; stepIndex < CONFIG_STEP_COUNT; ++stepIndex) {
+            auto &step = sequence.step(stepIndex);
+            step.setShape(stepIndex % Curve::Last);
+            step.setShapeVariation((stepIndex + 1) % Curve::Last);
+            step.setShapeVariationProbability(CurveSequence::ShapeVariationProbability::Max);
+            step.setGate(CurveSequence::Gate::Max);
+            step.setGateProbability(CurveSequence::GateProbability::Max);
+        }
+    }
+}
+
+static void setupMidiCvScenario(Project &project) {
+    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+        project.setTrackMode(trackIndex, Track::TrackMode::MidiCv);
+        auto &midiCvTrack = project.track(trackIndex).midiCvTrack();
+        midiCvTrack.setVoices(8);
+        auto &arpeggiator = midiCvTrack.arpeggiator();
+        arpeggiator.setEnabled(true);
+        arpeggiator.setHold(true);
+        arpeggiator.setDivisor(1);
+        arpeggiator.setOctaves(10);
+    }
+}
+
+struct Scenario {
+    const char *name;
+    std::function<void(Project &)> setup;
+    std::function<void(Project &)> setupRoutes;
+    bool holdNotes;
+};
+
+//----------------------------------------
+// Runner
+//----------------------------------------
+
+static void runScenario(FILE *file, const Scenario &scenario, int durationMs, int updateIntervalUs, bool last) {
+    std::unique_ptr<BenchTarget> target;
+    Samples updateSamples;
+    bool measure = false;
+
+    sim::Simulator simulator(sim::Target {
+        // create
+        [&] () {
+            target.reset(new BenchTarget(sim::Simulator::current()));
+        },
+        // destroy
+        [&] () {
+            target.reset();
+        },
+        // update
+        [&] () {
+            auto start = BenchClock::now();
+            target->engine.update();
+            if (measure) {
+                updateSamples.add(elapsedNs(start));
+            }
+        }
+    });
+    simulator.setUpdateInterval(updateIntervalUs);
+
+    // create target and build the project
+    simulator.wait(1);
+    auto &project = target->model.project();
+    project.setTempo(1000.f);
+    project.setSwing(60);
+    scenario.setup(project);
+    scenario.setupRoutes(project);
+
+    if (scenario.holdNotes) {
+        for (int note = 48; note < 48 + 16; note += 3) {
+            simulator.sendMidi(0, MidiMessage::makeNoteOn(0, note));
+        }
+    }
+
+    target->engine.clockStart();
+    simulator.wait(100);
+
+    // measure Engine::update() while modulating all route sources
+    target->engine.resetTimingStats();
+    measure = true;
+    auto wallStart = BenchClock::now();
+    for (int ms = 0; ms < durationMs; ++ms) {
+        float phase = ms * 0.001f;
+        for (int channel = 0; channel < CONFIG_CV_INPUT_CHANNELS; ++channel) {
+            simulator.setAdc(channel, 5.f * std::sin(6.2831853f * (phase + channel * 0.25f)));
+        }
+        if (ms % 4 == 0) {
+            int routeIndex = 1 + 2 * ((ms / 4) % (CONFIG_ROUTE_COUNT / 2));
+            simulator.sendMidi(0, MidiMessage::makeControlChange(0, routeIndex, (ms / 4) % 128));
+        }
+        simulator.wait(1);
+    }
+    double wallMs = std::chrono::duration<double, std::milli>(BenchClock::now() - wallStart).count();
+    measure = false;
+
+    auto &engine = target->engine;
+    auto timingStats = engine.timingStats();
+    uint32_t eventQueueOverflow = 0;
+    for (auto trackEngine : engine.trackEngines()) {
+        eventQueueOverflow += trackEngine->eventQueueOverflows();
+    }
+
+    // measure TrackEngine::tick() in isolation
+    Samples tickSamples;
+    uint32_t tick = engine.tick();
+    int tickCount = durationMs * 8;
+    for (int i = 0; i < tickCount; ++i, ++tick) {
+        for (auto trackEngine : engine.trackEngines()) {
+            auto start = BenchClock::now();
+            trackEngine->tick(tick);
+            tickSamples.add(elapsedNs(start));
+        }
+    }
+
+    std::fprintf(file, "    \"%s\": {\n", scenario.name);
+    std::fprintf(file, "      \"simulated_ms\": %d,\n", durationMs);
+    std::fprintf(file, "      \"wall_ms\": %.3f,\n", wallMs);
+    std::fprintf(file, "      \"event_queue_overflow\": %u,\n", eventQueueOverflow);
+    std::fprintf(file, "      ");
+    updateSamples.write(file, "engine_update");
+    std::fprintf(file, ",\n      ");
+    tickSamples.write(file, "track_tick");
+    std::fprintf(file, ",\n      \"timing\": {\n        ");
+    writeHistogram(file, "clock_jitter", timingStats.clockJitter);
+    std::fprintf(file, ",\n        ");
+    writeHistogram(file, "clock_output", timingStats.clockOutputLatency);
+    std::fprintf(file, ",\n        ");
+    writeHistogram(file, "gate_output", timingStats.gateOutputLatency);
+    std::fprintf(file, "\n      }");
+    std::fprintf(file, "\n    }%s\n", last ? "" : ",");
+}
+
+int main(int argc, char *argv[]) {
+    int durationMs = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const char *reportPath = argc > 2 ? argv[2] : nullptr;
+    int updateIntervalUs = argc > 3 ? std::atoi(argv[3]) : 1000;
+
+    if (durationMs <= 0 || updateIntervalUs <= 0) {
+        std::fprintf(stderr, "usage: %s [duration-ms] [report.json] [update-interval-us]\n", argv[0]);
+        return 1;
+    }
+
+    FILE *file = reportPath ? std::fopen(reportPath, "w") : stdout;
+    if (!file) {
+        std::fprintf(stderr, "failed to open '%s'\n", reportPath);
+        return 1;
+    }
+
+    const Scenario scenarios[] = {
+        { "note", setupNoteScenario, setupRoutes, false },
+        { "curve", setupCurveScenario, setupRoutes, false },
+        { "midi_cv", setupMidiCvScenario, setupRoutes, true },
+        { "sequence_routes", setupNoteScenario, setupSequenceRoutes, false },
+    };
+    const int scenarioCount = sizeof(scenarios) / sizeof(scenarios[0]);
+
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"benchmark\": \"engine\",\n");
+    std::fprintf(file, "  \"tracks\": %d,\n", CONFIG_TRACK_COUNT);
+    std::fprintf(file, "  \"routes\": %d,\n", CONFIG_ROUTE_COUNT);
+    std::fprintf(file, "  \"update_interval_us\": %d,\n", updateIntervalUs);
+    std::fprintf(file, "  \"scenarios\": {\n");
+    for (int i = 0; i < scenarioCount; ++i) {
+        runScenario(file, scenarios[i], durationMs, updateIntervalUs, i == scenarioCount - 1);
+    }
+    std::fprintf(file, "  }\n");
+    std::fprintf(file, "}\n");
+
+    if (file != stdout) {
+        std::fclose(file);
+    }
+
+    return 0;
+}
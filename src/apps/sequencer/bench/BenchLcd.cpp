@@ -0,0 +1,153 @@
+// LCD bandwidth benchmark
+//
+// Runs the sequencer headless on the simulator, visits the main pages and
+// reports the number of bytes sent to the display per second for each page,
+// with the clock stopped and running, as machine-readable JSON.
+//
+// Usage: bench_lcd [duration-ms] [report.json]
+
+#include "SequencerApp.h"
+
+#include "ui/Key.h"
+#include "ui/PageKeyMap.h"
+
+#include "sim/Simulator.h"
+
+#include <memory>
+
+#include <cstdio>
+#include <cstdlib>
+
+struct BenchPage {
+    const char *name;
+    int key;
+};
+
+static const BenchPage pages[] = {
+    { "project", PageKeyMap::Project },
+    { "layout", PageKeyMap::Layout },
+    { "routing", PageKeyMap::Routing },
+    { "midi_output", PageKeyMap::MidiOutput },
+    { "user_scale", PageKeyMap::UserScale },
+    { "sequence_edit", PageKeyMap::SequenceEdit },
+    { "sequence", PageKeyMap::Sequence },
+    { "track", PageKeyMap::Track },
+    { "song", PageKeyMap::Song },
+    { "overview", PageKeyMap::Overview },
+    { "clock", PageKeyMap::Clock },
+    { "pattern", PageKeyMap::Pattern },
+    { "performer", PageKeyMap::Performer },
+    { "monitor", PageKeyMap::Monitor },
+};
+
+// counts frames that changed the display content
+class FrameCounter : public sim::TargetOutputHandler {
+public:
+    void writeLcd(const sim::FrameBuffer &frameBuffer) override {
+        ++_frames;
+    }
+
+    uint32_t frames() const { return _frames; }
+
+private:
+    uint32_t _frames = 0;
+};
+
+static void pressKey(sim::Simulator &simulator, int key) {
+    simulator.setButton(key, true);
+    simulator.wait(10);
+    simulator.setButton(key, false);
+    simulator.wait(10);
+}
+
+static void showPage(sim::Simulator &simulator, int key) {
+    simulator.setButton(Key::Page, true);
+    simulator.wait(10);
+    pressKey(simulator, key);
+    simulator.setButton(Key::Page, false);
+    simulator.wait(100);
+}
+
+int main(int argc, char *argv[]) {
+    int durationMs = argc > 1 ? std::atoi(argv[1]) : 5000;
+    const char *reportPath = argc > 2 ? argv[2] : nullptr;
+
+    if (durationMs <= 0) {
+        std::fprintf(stderr, "usage: %s [duration-ms] [report.json]\n", argv[0]);
+        return 1;
+    }
+
+    FILE *file = reportPath ? std::fopen(reportPath, "w") : stdout;
+    if (!file) {
+        std::fprintf(stderr, "failed to open '%s'\n", reportPath);
+        return 1;
+    }
+
+    std::unique_ptr<SequencerApp> app;
+    FrameCounter frameCounter;
+
+    sim::Simulator simulator(sim::Target {
+        // create
+        [&] () {
+            app.reset(new SequencerApp(sim::Simulator::current()));
+        },
+        // destroy
+        [&] () {
+            app.reset();
+        },
+        // update
+        [&] () {
+            app->update();
+        }
+    });
+    simulator.registerTargetOutputObserver(&frameCounter);
+
+    // wait for the startup page to finish
+    simulator.wait(3000);
+
+    const int pageCount = sizeof(pages) / sizeof(pages[0]);
+    const uint32_t fullFrameBytes = CONFIG_LCD_WIDTH * CONFIG_LCD_HEIGHT / 2;
+
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"benchmark\": \"lcd\",\n");
+    std::fprintf(file, "  \"full_frame_bytes\": %u,\n", fullFrameBytes);
+    std::fprintf(file, "  \"pages\": {\n");
+
+    for (int i = 0; i < pageCount; ++i) {
+        const auto &page = pages[i];
+        std::fprintf(file, "    \"%s\": {", page.name);
+
+        for (int running = 0; running < 2; ++running) {
+            if (running) {
+                app->engine.clockStart();
+            } else {
+                app->engine.clockStop();
+            }
+            showPage(simulator, page.key);
+
+            uint32_t bytesSent = app->lcd.bytesSent();
+            uint32_t frames = frameCounter.frames();
+            simulator.wait(durationMs);
+            bytesSent = app->lcd.bytesSent() - bytesSent;
+            frames = frameCounter.frames() - frames;
+
+            std::fprintf(file, "%s \"%s\": { \"bytes_per_s\": %.1f, \"changed_frames_per_s\": %.1f }",
+                running ? "," : "",
+                running ? "running" : "stopped",
+                bytesSent * 1000.0 / durationMs,
+                frames * 1000.0 / durationMs
+            );
+        }
+
+        std::fprintf(file, " }%s\n", i == pageCount - 1 ? "" : ",");
+    }
+
+    std::fprintf(file, "  }\n");
+    std::fprintf(file, "}\n");
+
+    if (file != stdout) {
+        std::fclose(file);
+    }
+
+    return 0;
+}
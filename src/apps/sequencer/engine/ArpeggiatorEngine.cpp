@@ -4,16 +4,14 @@
 #include "Groove.h"
 
 #include "core/Debug.h"
-#include "core/utils/Random.h"
 
 #include "os/os.h"
 
 #include <cinttypes>
 
-static Random rng;
-
-ArpeggiatorEngine::ArpeggiatorEngine(const Arpeggiator &arpeggiator) :
-    _arpeggiator(arpeggiator)
+ArpeggiatorEngine::ArpeggiatorEngine(const Arpeggiator &arpeggiator, uint32_t seed) :
+    _arpeggiator(arpeggiator),
+    _rng(seed)
 {
     reset();
 }
@@ -191,7 +189,7 @@ void ArpeggiatorEngine::advanceStep() {
         break;
     case Arpeggiator::Mode::Random:
         _stepIndex = (_stepIndex + 1) % _noteCount;
-        _noteIndex = rng.nextRange(_noteCount);
+        _noteIndex = _rng.nextRange(_noteCount);
         break;
     case Arpeggiator::Mode::Last:
         break;
@@ -1,9 +1,13 @@
 #pragma once
 
-#include "SortedQueue.h"
+#include "Config.h"
+
+#include "EventQueue.h"
 
 #include "model/Arpeggiator.h"
 
+#include "core/utils/Random.h"
+
 #include <array>
 
 #include <cstdint>
@@ -20,7 +24,7 @@ public:
         uint8_t velocity;
     };
 
-    ArpeggiatorEngine(const Arpeggiator &arpeggiator);
+    ArpeggiatorEngine(const Arpeggiator &arpeggiator, uint32_t seed = 0);
 
     void reset();
 
@@ -31,6 +35,8 @@ public:
 
     bool getEvent(uint32_t tick, Event &event);
 
+    uint32_t eventQueueOverflows() const { return _eventQueue.overflows(); }
+
 private:
     void addNote(int note);
     void removeNote(int note);
@@ -43,6 +49,7 @@ private:
     static constexpr int MaxNotes = 8;
 
     const Arpeggiator &_arpeggiator;
+    Random _rng;
 
     int _stepIndex;
     int _noteIndex;
@@ -65,5 +72,5 @@ private:
         }
     };
 
-    SortedQueue<Event, 16, EventCompare> _eventQueue;
+    EventQueue<Event, CONFIG_EVENT_QUEUE_SIZE, EventCompare> _eventQueue;
 };
@@ -66,7 +66,7 @@ void Clock::masterStart() {
 
     _timer.disable();
     setupMasterTimer();
-    _timer.enable();
+    startTimer();
 }
 
 void Clock::masterStop() {
@@ -94,7 +94,7 @@ void Clock::masterContinue() {
 
     _timer.disable();
     setupMasterTimer();
-    _timer.enable();
+    startTimer();
 }
 
 void Clock::masterReset() {
@@ -165,6 +165,9 @@ void Clock::slaveTick(int slave) {
         }
 
         _lastSlaveTickUs = _elapsedUs;
+
+        _slaveInputPending = true;
+        _slaveInputUs = _timer.timeUs();
     }
 }
 
@@ -187,7 +190,7 @@ void Clock::slaveStart(int slave) {
 
     _timer.disable();
     setupSlaveTimer();
-    _timer.enable();
+    startTimer();
 }
 
 void Clock::slaveStop(int slave) {
@@ -224,7 +227,7 @@ void Clock::slaveContinue(int slave) {
     requestContinue();
 
     setupSlaveTimer();
-    _timer.enable();
+    startTimer();
 }
 
 void Clock::slaveReset(int slave) {
@@ -309,11 +312,27 @@ bool Clock::checkTick(uint32_t *tick) {
     return false;
 }
 
+Clock::TimingStats Clock::timingStats() const {
+    os::InterruptLock lock;
+    return _timingStats;
+}
+
+void Clock::resetTimingStats() {
+    os::InterruptLock lock;
+    _timingStats.tickJitter.reset();
+    _timingStats.slaveLatency.reset();
+}
+
 void Clock::onClockTimerTick() {
     os::InterruptLock lock;
 
+    // track the ideal time of timer ticks
+    uint32_t timeUs = _timer.timeUs();
+    _timerTickUs += _timer.period();
+
     switch (_state) {
     case State::MasterRunning: {
+        recordTick(_timerTickUs, timeUs);
         outputTick(_tick);
         ++_tick;
         _elapsedUs += _timer.period();
@@ -323,6 +342,12 @@ void Clock::onClockTimerTick() {
         _elapsedUs += _timer.period();
 
         if (_slaveSubTicksPending > 0 && _elapsedUs >= _nextSlaveSubTickUs) {
+            // sub ticks are quantized to the timer period
+            recordTick(_timerTickUs - (_elapsedUs - _nextSlaveSubTickUs), timeUs);
+            if (_slaveInputPending) {
+                _timingStats.slaveLatency.record(int32_t(timeUs - _slaveInputUs));
+                _slaveInputPending = false;
+            }
             outputTick(_tick);
             ++_tick;
             --_slaveSubTicksPending;
@@ -397,6 +422,17 @@ void Clock::setupSlaveTimer() {
     _timer.setPeriod(SlaveTimerPeriod);
 }
 
+void Clock::startTimer() {
+    _timerTickUs = _timer.timeUs();
+    _slaveInputPending = false;
+    _timer.enable();
+}
+
+void Clock::recordTick(uint32_t idealUs, uint32_t timeUs) {
+    _tickTimes[_tick % TickTimeCount] = idealUs;
+    _timingStats.tickJitter.record(int32_t(timeUs - idealUs));
+}
+
 void Clock::outputMidiMessage(uint8_t msg) {
     os::InterruptLock lock;
     if (_listener) {
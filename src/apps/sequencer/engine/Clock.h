@@ -3,6 +3,7 @@
 #include "Config.h"
 
 #include "core/utils/MovingAverage.h"
+#include "core/utils/TimingHistogram.h"
 
 #include "drivers/ClockTimer.h"
 
@@ -32,6 +33,11 @@ public:
         bool run = false;
     };
 
+    struct TimingStats {
+        TimingHistogram tickJitter;     // actual vs. ideal time of generated ticks
+        TimingHistogram slaveLatency;   // slave input tick to first generated tick
+    };
+
     struct Listener {
         virtual void onClockOutput(const OutputState &state) = 0;
         virtual void onClockMidi(uint8_t) = 0;
@@ -83,6 +89,14 @@ public:
     Event checkEvent();
     bool checkTick(uint32_t *tick);
 
+    // Timing
+    // current time of the clock timer time base (in us)
+    uint32_t timeUs() const { return _timer.timeUs(); }
+    // ideal time of one of the most recently generated ticks
+    uint32_t tickTime(uint32_t tick) const { return _tickTimes[tick % TickTimeCount]; }
+    TimingStats timingStats() const;
+    void resetTimingStats();
+
 private:
     enum class State {
         Idle,
@@ -105,6 +119,8 @@ private:
 
     void setupMasterTimer();
     void setupSlaveTimer();
+    void startTimer();
+    void recordTick(uint32_t idealUs, uint32_t timeUs);
 
     void outputMidiMessage(uint8_t msg);
     void outputTick(uint32_t tick);
@@ -116,6 +132,7 @@ private:
 
     static constexpr uint32_t SlaveTimerPeriod = 100; // us
     static constexpr size_t SlaveCount = 4;
+    static constexpr size_t TickTimeCount = 16;
 
     Listener *_listener = nullptr;
 
@@ -161,4 +178,10 @@ private:
     float _slaveBpmFiltered = 0.f;
     MovingAverage<float, 4> _slaveBpmAvg;
     float _slaveBpm = 0.f;
+
+    uint32_t _timerTickUs; // ideal time of last timer tick
+    bool _slaveInputPending = false;
+    uint32_t _slaveInputUs; // time of last slave input tick
+    uint32_t _tickTimes[TickTimeCount];
+    TimingStats _timingStats;
 };
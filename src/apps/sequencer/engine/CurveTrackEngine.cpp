@@ -11,8 +11,6 @@
 #include "model/Curve.h"
 #include "model/Types.h"
 
-static Random rng;
-
 static float evalStepShape(const CurveSequence::Step &step, bool variation, bool invert, float fraction) {
     auto function = Curve::function(Curve::Type(variation ? step.shapeVariation() : step.shape()));
     float value = function(fraction);
@@ -24,12 +22,12 @@ static float evalStepShape(const CurveSequence::Step &step, bool variation, bool
     return min + value * (max - min);
 }
 
-static bool evalShapeVariation(const CurveSequence::Step &step, int probabilityBias) {
+static bool evalShapeVariation(Random &rng, const CurveSequence::Step &step, int probabilityBias) {
     int probability = clamp(step.shapeVariationProbability() + probabilityBias, 0, 8);
     return int(rng.nextRange(8)) < probability;
 }
 
-static bool evalGate(const CurveSequence::Step &step, int probabilityBias) {
+static bool evalGate(Random &rng, const CurveSequence::Step &step, int probabilityBias) {
     int probability = clamp(step.gateProbability() + probabilityBias, -1, CurveSequence::GateProbability::Max);
     return int(rng.nextRange(CurveSequence::GateProbability::Range)) <= probability;
 }
@@ -87,11 +85,11 @@ void CurveTrackEngine::tick(uint32_t tick) {
             // advance sequence
             switch (_curveTrack.playMode()) {
             case Types::PlayMode::Aligned:
-                _sequenceState.advanceAligned(relativeTick / divisor, sequence.runMode(), sequence.firstStep(), sequence.lastStep(), rng);
+                _sequenceState.advanceAligned(relativeTick / divisor, sequence.runMode(), sequence.firstStep(), sequence.lastStep(), _rng);
                 triggerStep(tick, divisor);
                 break;
             case Types::PlayMode::Free:
-                _sequenceState.advanceFree(sequence.runMode(), sequence.firstStep(), sequence.lastStep(), rng);
+                _sequenceState.advanceFree(sequence.runMode(), sequence.firstStep(), sequence.lastStep(), _rng);
                 triggerStep(tick, divisor);
                 break;
             case Types::PlayMode::Last:
@@ -149,15 +147,15 @@ void CurveTrackEngine::triggerStep(uint32_t tick, uint32_t divisor) {
     _currentStep = SequenceUtils::rotateStep(_sequenceState.step(), sequence.firstStep(), sequence.lastStep(), rotate);
     const auto &step = sequence.step(_currentStep);
 
-    _shapeVariation = evalShapeVariation(step, shapeProbabilityBias);
+    _shapeVariation = evalShapeVariation(_rng, step, shapeProbabilityBias);
 
-    bool fillStep = fill() && (rng.nextRange(100) < uint32_t(fillAmount()));
+    bool fillStep = fill() && (_rng.nextRange(100) < uint32_t(fillAmount()));
     _fillMode = fillStep ? _curveTrack.fillMode() : CurveTrack::FillMode::None;
 
     // Trigger gate pattern
     int gate = step.gate();
     for (int i = 0; i < 4; ++i) {
-        if (gate & (1 << i) && evalGate(step, gateProbabilityBias)) {
+        if (gate & (1 << i) && evalGate(_rng, step, gateProbabilityBias)) {
             uint32_t gateStart = (divisor * i) / 4;
             uint32_t gateLength = divisor / 8;
             _gateQueue.pushReplace({ Groove::applySwing(tick + gateStart, swing()), true });
@@ -2,7 +2,7 @@
 
 #include "TrackEngine.h"
 #include "SequenceState.h"
-#include "SortedQueue.h"
+#include "EventQueue.h"
 #include "CurveRecorder.h"
 
 #include "model/Track.h"
@@ -11,7 +11,8 @@ class CurveTrackEngine : public TrackEngine {
 public:
     CurveTrackEngine(Engine &engine, const Model &model, Track &track, const TrackEngine *linkedTrackEngine) :
         TrackEngine(engine, model, track, linkedTrackEngine),
-        _curveTrack(track.curveTrack())
+        _curveTrack(track.curveTrack()),
+        _rng(track.trackIndex())
     {
         reset();
     }
@@ -34,6 +35,8 @@ public:
         return _currentStep < 0 ? 0.f : float(_currentStep - _sequence->firstStep()) / (_sequence->lastStep() - _sequence->firstStep());
     }
 
+    virtual uint32_t eventQueueOverflows() const override { return _gateQueue.overflows(); }
+
     const CurveSequence &sequence() const { return *_sequence; }
     bool isActiveSequence(const CurveSequence &sequence) const { return &sequence == _sequence; }
 
@@ -57,6 +60,7 @@ private:
 
     CurveSequence *_sequence;
     CurveSequence *_fillSequence;
+    Random _rng;
     SequenceState _sequenceState;
     int _currentStep;
     float _currentStepFraction;
@@ -79,5 +83,5 @@ private:
         }
     };
 
-    SortedQueue<Gate, 16, GateCompare> _gateQueue;
+    EventQueue<Gate, CONFIG_EVENT_QUEUE_SIZE, GateCompare> _gateQueue;
 };
@@ -12,8 +12,10 @@ void CvOutput::init() {
 }
 
 void CvOutput::update() {
+    std::array<uint16_t, Channels> values;
+    _calibration.cvOutputVoltsToValues(_channels, values);
     for (int i = 0; i < Channels; ++i) {
-        _dac.setValue(i, _calibration.cvOutput(i).voltsToValue(_channels[i]));
+        _dac.setValue(i, values[i]);
     }
     _dac.write();
 }
@@ -4,9 +4,16 @@
 
 #include "core/Debug.h"
 #include "core/midi/MidiMessage.h"
+#include "core/profiler/Profiler.h"
 
 #include "os/os.h"
 
+PROFILER_INTERVAL(engine_update, "Engine::update")
+PROFILER_INTERVAL(track_tick, "TrackEngine::tick")
+
+// number of midi messages received per driver call
+static constexpr size_t MidiRecvBlockSize = 16;
+
 Engine::Engine(Model &model, ClockTimer &clockTimer, Adc &adc, Dac &dac, Dio &dio, GateOutput &gateOutput, Midi &midi, UsbMidi &usbMidi) :
     _model(model),
     _project(model.project()),
@@ -33,6 +40,7 @@ void Engine::init() {
     _clock.init();
 
     initClock();
+    updateProjectSetup();
     updateClockSetup();
 
     // setup track engines
@@ -43,6 +51,8 @@ void Engine::init() {
 }
 
 void Engine::update() {
+    PROFILER_INTERVAL_SCOPE(engine_update);
+
     uint32_t systemTicks = os::ticks();
     float dt = (0.001f * (systemTicks - _lastSystemTicks)) / os::time::ms(1);
     _lastSystemTicks = systemTicks;
@@ -64,9 +74,9 @@ void Engine::update() {
         while (_clock.checkTick(&tick)) {}
 
         // consume midi events
-        MidiMessage message;
-        while (_midi.recv(&message)) {}
-        while (_usbMidi.recv(&message)) {}
+        MidiMessage messages[MidiRecvBlockSize];
+        while (_midi.recv(messages, MidiRecvBlockSize) > 0) {}
+        while (_usbMidi.recv(messages, MidiRecvBlockSize) > 0) {}
 
         _cvInput.update();
         updateOverrides();
@@ -103,14 +113,21 @@ void Engine::update() {
     _nudgeTempo.update(dt);
     _clock.setMasterBpm(_project.tempo() * (1.f + _nudgeTempo.strength() * 0.1f));
 
+    // update project setup
+    bool changed = updateProjectSetup();
+
     // update clock setup
-    updateClockSetup();
+    changed |= updateClockSetup();
 
     // update track setups
-    updateTrackSetups();
+    changed |= updateTrackSetups();
 
     // update play state
-    updatePlayState(false);
+    changed |= updatePlayState(false);
+
+    if (!changed) {
+        ++_setupSkipped;
+    }
 
     // update cv inputs
     _cvInput.update();
@@ -122,14 +139,17 @@ void Engine::update() {
     _routingEngine.update();
 
     uint32_t tick;
+    bool ticked = false;
     while (_clock.checkTick(&tick)) {
         _tick = tick;
+        ticked = true;
 
         // update play state
         updatePlayState(true);
 
-        for (auto trackEngine : _trackEngines) {
-            trackEngine->tick(tick);
+        for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+            PROFILER_INTERVAL_SCOPE(track_tick, trackIndex);
+            _trackEngines[trackIndex]->tick(tick);
         }
 
         _midiOutputEngine.tick(tick);
@@ -145,6 +165,13 @@ void Engine::update() {
     // update cv/gate outputs
     _cvOutput.update();
     _gateOutput.update();
+
+    // gate edges are attributed to the last processed tick
+    uint8_t gates = _gateOutput.gates();
+    if (ticked && gates != _lastGates && !_gateOutputOverride) {
+        _gateOutputLatency.record(int32_t(_clock.timeUs() - _clock.tickTime(tick)));
+    }
+    _lastGates = gates;
 }
 
 void Engine::lock() {
@@ -292,6 +319,19 @@ bool Engine::sendMidi(MidiPort port, const MidiMessage &message) {
     return false;
 }
 
+bool Engine::sendSysEx(MidiPort port, const uint8_t *data, size_t length) {
+    switch (port) {
+    case MidiPort::UsbMidi:
+        return _usbMidi.sendSysEx(data, length);
+    case MidiPort::Midi:
+        // only used for usb controllers
+    case MidiPort::CvGate:
+        // input only
+        break;
+    }
+    return false;
+}
+
 void Engine::showMessage(const char *text, uint32_t duration) {
     if (_messageHandler) {
         _messageHandler(text, duration);
@@ -303,13 +343,42 @@ void Engine::setMessageHandler(MessageHandler handler) {
 }
 
 Engine::Stats Engine::stats() const {
+    uint32_t eventQueueOverflow = _eventQueueOverflow;
+    for (const auto trackEngine : _trackEngines) {
+        eventQueueOverflow += trackEngine->eventQueueOverflows();
+    }
+
     return {
         .uptime = os::ticks() / os::time::ms(1000),
         .midiRxOverflow = _midi.rxOverflow(),
-        .usbMidiRxOverflow = _usbMidi.rxOverflow()
+        .usbMidiRxOverflow = _usbMidi.rxOverflow(),
+        .midiTxHighWatermark = _midi.txHighWatermark(),
+        .midiTxBytesSaved = _midi.txBytesSaved(),
+        .eventQueueOverflow = eventQueueOverflow,
+        .setupSkipped = _setupSkipped
+    };
+}
+
+Engine::TimingStats Engine::timingStats() const {
+    auto clockStats = _clock.timingStats();
+
+    os::InterruptLock lock;
+    return {
+        .clockJitter = clockStats.tickJitter,
+        .slaveLatency = clockStats.slaveLatency,
+        .clockOutputLatency = _clockOutputLatency,
+        .gateOutputLatency = _gateOutputLatency
     };
 }
 
+void Engine::resetTimingStats() {
+    _clock.resetTimingStats();
+
+    os::InterruptLock lock;
+    _clockOutputLatency.reset();
+    _gateOutputLatency.reset();
+}
+
 void Engine::onClockOutput(const Clock::OutputState &state) {
     _dio.clockOutput.set(state.clock);
     switch (_project.clockSetup().clockOutputMode()) {
@@ -322,22 +391,52 @@ void Engine::onClockOutput(const Clock::OutputState &state) {
     case ClockSetup::ClockOutputMode::Last:
         break;
     }
+
+    // clock edges generated by a running clock are attributed to the current tick
+    if (state.clock != _lastClockOutput && _clock.isRunning()) {
+        _clockOutputLatency.record(int32_t(_clock.timeUs() - _clock.tickTime(_clock.tick())));
+    }
+    _lastClockOutput = state.clock;
 }
 
 void Engine::onClockMidi(uint8_t data) {
-    // TODO we should send a single byte with priority
+    // clock bytes are sent ahead of queued note and cc messages
     const auto &clockSetup = _project.clockSetup();
     if (clockSetup.midiTx()) {
-        _midi.send(MidiMessage(data));
+        _midi.sendRealTime(data);
     }
     if (clockSetup.usbTx()) {
-        _usbMidi.send(MidiMessage(data));
+        _usbMidi.sendRealTime(data);
     }
 }
 
-void Engine::updateTrackSetups() {
+bool Engine::updateProjectSetup() {
+    if (!_project.isDirty()) {
+        return false;
+    }
+
+    _project.clearDirty();
+    _measureDivisor = measureDivisor();
+    _syncDivisor = syncDivisor();
+
+    return true;
+}
+
+bool Engine::updateTrackSetups() {
+    bool dirty = false;
+    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+        dirty |= !_trackEngines[trackIndex] || _project.track(trackIndex).isDirty();
+    }
+    if (!dirty) {
+        return false;
+    }
+
+    // changing a track engine affects linked tracks, so update all of them
+    _midiTrackEngines = 0;
     for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
         auto &track = _project.track(trackIndex);
+        track.clearDirty();
+
         int linkTrack = track.linkTrack();
         const TrackEngine *linkedTrackEngine = linkTrack >= 0 ? &trackEngine(linkTrack) : nullptr;
 
@@ -345,6 +444,10 @@ void Engine::updateTrackSetups() {
             auto &trackEngine = _trackEngines[trackIndex];
             auto &trackContainer = _trackEngineContainers[trackIndex];
 
+            if (trackEngine) {
+                _eventQueueOverflow += trackEngine->eventQueueOverflows();
+            }
+
             switch (track.trackMode()) {
             case Track::TrackMode::Note:
                 trackEngine = trackContainer.create<NoteTrackEngine>(*this, _model, track, linkedTrackEngine);
@@ -362,7 +465,13 @@ void Engine::updateTrackSetups() {
 
         // update linked track engine
         _trackEngines[trackIndex]->setLinkedTrackEngine(linkedTrackEngine);
+
+        if (track.trackMode() == Track::TrackMode::MidiCv) {
+            _midiTrackEngines |= 1 << trackIndex;
+        }
     }
+
+    return true;
 }
 
 void Engine::updateTrackOutputs() {
@@ -397,18 +506,31 @@ void Engine::reset() {
     _midiOutputEngine.reset();
 }
 
-void Engine::updatePlayState(bool ticked) {
+bool Engine::updatePlayState(bool ticked) {
     auto &playState = _project.playState();
     auto &songState = playState.songState();
     const auto &song = _project.song();
 
+    // abort song mode if slot becomes invalid
+    // the song can be edited without any pending request, the stop request is handled below
+
+    if (songState.playing() &&
+        (songState.currentSlot() >= song.slotCount() || songState.currentRepeat() >= song.slot(songState.currentSlot()).repeats())) {
+        playState.stopSong();
+    }
+
+    // requests are only handled when made, song state only advances on ticks
+    if (!ticked && !playState.isDirty()) {
+        return false;
+    }
+
     bool hasImmediateRequests = playState.hasImmediateRequests();
     bool hasSyncedRequests = playState.hasSyncedRequests();
     bool handleLatchedRequests = playState.executeLatchedRequests();
     bool hasRequests = hasImmediateRequests || hasSyncedRequests || handleLatchedRequests;
 
-    bool handleSyncedRequests = _tick % syncDivisor() == 0;
-    bool handleSongAdvance = ticked && _tick > 0 && _tick % measureDivisor() == 0;
+    bool handleSyncedRequests = hasSyncedRequests && _tick % _syncDivisor == 0;
+    bool handleSongAdvance = ticked && _tick > 0 && _tick % _measureDivisor == 0;
 
     // handle mute & pattern requests
 
@@ -520,18 +642,13 @@ void Engine::updatePlayState(bool ticked) {
         }
     }
 
-    // abort song mode if slot becomes invalid
-
-    if ((songState.playing() && songState.currentSlot() >= song.slotCount()) ||
-        (songState.currentRepeat() >= song.slot(songState.currentSlot()).repeats())) {
-        playState.stopSong();
-    }
-
     if (hasRequests | handleSongAdvance) {
         for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
             _trackEngines[trackIndex]->changePattern();
         }
     }
+
+    return true;
 }
 
 void Engine::updateOverrides() {
@@ -559,14 +676,20 @@ void Engine::usbMidiDisconnect() {
 }
 
 void Engine::receiveMidi() {
-    MidiMessage message;
-    while (_midi.recv(&message)) {
-        message.fixFakeNoteOff();
-        receiveMidi(MidiPort::Midi, message);
+    // receive messages in blocks
+    MidiMessage messages[MidiRecvBlockSize];
+    size_t count;
+    while ((count = _midi.recv(messages, MidiRecvBlockSize)) > 0) {
+        for (size_t i = 0; i < count; ++i) {
+            messages[i].fixFakeNoteOff();
+            receiveMidi(MidiPort::Midi, messages[i]);
+        }
     }
-    while (_usbMidi.recv(&message)) {
-        message.fixFakeNoteOff();
-        receiveMidi(MidiPort::UsbMidi, message);
+    while ((count = _usbMidi.recv(messages, MidiRecvBlockSize)) > 0) {
+        for (size_t i = 0; i < count; ++i) {
+            messages[i].fixFakeNoteOff();
+            receiveMidi(MidiPort::UsbMidi, messages[i]);
+        }
     }
 
     // derive MIDI messages from CV/Gate input
@@ -613,8 +736,8 @@ void Engine::receiveMidi(MidiPort port, const MidiMessage &message) {
     }
 
     // let track engines consume messages (only MIDI/CV tracks)
-    for (auto trackEngine : _trackEngines) {
-        if (trackEngine->receiveMidi(port, message)) {
+    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+        if ((_midiTrackEngines & (1 << trackIndex)) && _trackEngines[trackIndex]->receiveMidi(port, message)) {
             return;
         }
     }
@@ -720,14 +843,14 @@ void Engine::initClock() {
     });
 }
 
-void Engine::updateClockSetup() {
+bool Engine::updateClockSetup() {
     auto &clockSetup = _project.clockSetup();
 
     // Update clock swing
     _clock.outputConfigureSwing(clockSetup.clockOutputSwing() ? _project.swing() : 0);
 
     if (!clockSetup.isDirty()) {
-        return;
+        return false;
     }
 
     // Configure clock mode
@@ -785,4 +908,6 @@ void Engine::updateClockSetup() {
     onClockOutput(_clock.outputState());
 
     clockSetup.clearDirty();
+
+    return true;
 }
@@ -53,6 +53,17 @@ public:
         uint32_t uptime;
         uint32_t midiRxOverflow;
         uint32_t usbMidiRxOverflow;
+        uint32_t midiTxHighWatermark;
+        uint32_t midiTxBytesSaved;
+        uint32_t eventQueueOverflow;
+        uint32_t setupSkipped;
+    };
+
+    struct TimingStats {
+        TimingHistogram clockJitter;        // generated clock ticks
+        TimingHistogram slaveLatency;       // slave input tick to generated clock tick
+        TimingHistogram clockOutputLatency; // clock output edges
+        TimingHistogram gateOutputLatency;  // gate output edges
     };
 
     Engine(Model &model, ClockTimer &clockTimer, Adc &adc, Dac &dac, Dio &dio, GateOutput &gateOutput, Midi &midi, UsbMidi &usbMidi);
@@ -137,6 +148,7 @@ public:
     bool trackEnginesConsistent() const;
 
     bool sendMidi(MidiPort port, const MidiMessage &message);
+    bool sendSysEx(MidiPort port, const uint8_t *data, size_t length);
     void setMidiReceiveHandler(MidiReceiveHandler handler) { _midiReceiveHandler = handler; }
     void setUsbMidiConnectHandler(UsbMidiConnectHandler handler) { _usbMidiConnectHandler = handler; }
     void setUsbMidiDisconnectHandler(UsbMidiDisconnectHandler handler) { _usbMidiDisconnectHandler = handler; }
@@ -147,15 +159,20 @@ public:
 
     Stats stats() const;
 
+    // timing deltas of clock and gate output edges (in us)
+    TimingStats timingStats() const;
+    void resetTimingStats();
+
 private:
     // Clock::Listener
     virtual void onClockOutput(const Clock::OutputState &state) override;
     virtual void onClockMidi(uint8_t data) override;
 
-    void updateTrackSetups();
+    bool updateProjectSetup();
+    bool updateTrackSetups();
     void updateTrackOutputs();
     void reset();
-    void updatePlayState(bool ticked);
+    bool updatePlayState(bool ticked);
     void updateOverrides();
 
     void usbMidiConnect(uint16_t vendorId, uint16_t productId);
@@ -166,7 +183,7 @@ private:
     void monitorMidi(const MidiMessage &message);
 
     void initClock();
-    void updateClockSetup();
+    bool updateClockSetup();
 
     Model &_model;
     Project &_project;
@@ -186,6 +203,7 @@ private:
 
     TrackEngineContainerArray _trackEngineContainers;
     TrackEngineArray _trackEngines;
+    uint8_t _midiTrackEngines = 0; // track engines receiving midi (MIDI/CV tracks)
 
     MidiOutputEngine _midiOutputEngine;
 
@@ -204,8 +222,24 @@ private:
 
     uint32_t _tick = 0;
 
+    // time base of the project, updated when the project is dirty
+    uint32_t _measureDivisor = 0;
+    uint32_t _syncDivisor = 0;
+
     uint32_t _lastSystemTicks = 0;
 
+    // event queue overflows of track engines that have been replaced
+    uint32_t _eventQueueOverflow = 0;
+
+    // number of updates that skipped the setup and play state updates
+    uint32_t _setupSkipped = 0;
+
+    // output timing
+    bool _lastClockOutput = false;
+    uint8_t _lastGates = 0;
+    TimingHistogram _clockOutputLatency;
+    TimingHistogram _gateOutputLatency;
+
     // midi monitoring
     struct {
         int8_t lastNote = -1;
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <functional>
+
+#include <cstddef>
+#include <cstdint>
+
+// Fixed capacity queue for scheduling timed events.
+// Events are kept in a binary min-heap ordered by Compare, events comparing equal
+// are returned in insertion order. If the queue is full, the latest event is dropped
+// and counted as an overflow.
+template<typename T, size_t Capacity, typename Compare = std::less<T>>
+class EventQueue {
+public:
+    void clear() {
+        _size = 0;
+    }
+
+    size_t capacity() const { return Capacity; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    bool full() const { return _size == Capacity; }
+
+    // number of events dropped due to the queue being full
+    uint32_t overflows() const { return _overflows; }
+
+    void push(const T &value) {
+        Entry entry = { value, _order++ };
+
+        if (_size < Capacity) {
+            _heap[_size++] = entry;
+            std::push_heap(_heap.begin(), _heap.begin() + _size, Later());
+            return;
+        }
+
+        ++_overflows;
+
+        // replace the latest event (always a leaf) if the new event is scheduled earlier
+        auto latest = std::max_element(_heap.begin() + _size / 2, _heap.begin() + _size, Earlier());
+        if (Earlier()(entry, *latest)) {
+            *latest = entry;
+            std::push_heap(_heap.begin(), latest + 1, Later());
+        }
+    }
+
+    // push value and drop all events scheduled after it
+    void pushReplace(const T &value) {
+        Compare compare;
+        auto end = std::remove_if(_heap.begin(), _heap.begin() + _size, [&] (const Entry &entry) {
+            return compare(value, entry.value);
+        });
+        size_t size = end - _heap.begin();
+        if (size != _size) {
+            _size = size;
+            std::make_heap(_heap.begin(), _heap.begin() + _size, Later());
+        }
+        push(value);
+    }
+
+    const T &front() const { return _heap[0].value; }
+
+    void pop() {
+        if (_size > 0) {
+            std::pop_heap(_heap.begin(), _heap.begin() + _size, Later());
+            --_size;
+        }
+    }
+
+private:
+    struct Entry {
+        T value;
+        uint32_t order;
+    };
+
+    struct Earlier {
+        bool operator()(const Entry &a, const Entry &b) {
+            Compare compare;
+            if (compare(a.value, b.value)) {
+                return true;
+            }
+            if (compare(b.value, a.value)) {
+                return false;
+            }
+            return int32_t(a.order - b.order) < 0;
+        }
+    };
+
+    struct Later {
+        bool operator()(const Entry &a, const Entry &b) {
+            return Earlier()(b, a);
+        }
+    };
+
+    std::array<Entry, Capacity> _heap;
+    size_t _size = 0;
+    uint32_t _order = 0;
+    uint32_t _overflows = 0;
+};
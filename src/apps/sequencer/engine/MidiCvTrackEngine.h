@@ -10,7 +10,7 @@ public:
     MidiCvTrackEngine(Engine &engine, const Model &model, Track &track, const TrackEngine *linkedTrackEngine) :
         TrackEngine(engine, model, track, linkedTrackEngine),
         _midiCvTrack(track.midiCvTrack()),
-        _arpeggiatorEngine(_midiCvTrack.arpeggiator())
+        _arpeggiatorEngine(_midiCvTrack.arpeggiator(), track.trackIndex())
     {
         reset();
     }
@@ -28,6 +28,8 @@ public:
     virtual bool gateOutput(int index) const override;
     virtual float cvOutput(int index) const override;
 
+    virtual uint32_t eventQueueOverflows() const override { return _arpeggiatorEngine.eventQueueOverflows(); }
+
 private:
     static constexpr size_t VoiceCount = 8;
     static constexpr int RetriggerDelay = 2;
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Config.h"
+
+#include "model/NoteSequence.h"
+#include "model/Scale.h"
+
+#include <array>
+
+#include <cstdint>
+
+// Compiled play plan of a note sequence.
+// Caches the per step values that only depend on the step data and the sequence wide
+// parameters (scale, root note, octave, transpose, divisor, length bias). Steps are
+// compiled on first use and recompiled when either the step or the parameters change,
+// leaving only the probabilistic parts to be evaluated when triggering a step.
+class NotePlayPlan {
+public:
+    struct Params {
+        const Scale *scale;
+        uint32_t scaleRevision;
+        int rootNote;
+        int octave;
+        int transpose;
+        uint32_t divisor;
+        int lengthBias;
+
+        bool operator==(const Params &other) const {
+            return (
+                scale == other.scale &&
+                scaleRevision == other.scaleRevision &&
+                rootNote == other.rootNote &&
+                octave == other.octave &&
+                transpose == other.transpose &&
+                divisor == other.divisor &&
+                lengthBias == other.lengthBias
+            );
+        }
+
+        bool operator!=(const Params &other) const {
+            return !(*this == other);
+        }
+    };
+
+    struct Step {
+        float volts;            // note voltage without variation
+        int16_t note;           // note including root note and transposition
+        uint16_t gateOffset;    // gate offset in ticks
+        uint16_t gateLength;    // gate length in ticks without variation
+        uint16_t key;           // step data the entry was compiled from
+    };
+
+    NotePlayPlan() {
+        invalidate();
+    }
+
+    void invalidate() {
+        _valid = 0;
+        _params.scale = nullptr;
+    }
+
+    const Params &params() const { return _params; }
+
+    void setParams(const Params &params) {
+        if (params != _params) {
+            _params = params;
+            _valid = 0;
+        }
+    }
+
+    // returns the compiled step, compiles the step if needed
+    const Step &step(int index, const NoteSequence::Step &step) {
+        auto &entry = _steps[index];
+        uint64_t mask = uint64_t(1) << index;
+        uint16_t key = stepKey(step);
+        if (!(_valid & mask) || entry.key != key) {
+            compile(_params, step, entry);
+            entry.key = key;
+            _valid |= mask;
+        }
+        return entry;
+    }
+
+    // compiles a step without caching it
+    static void compile(const Params &params, const NoteSequence::Step &step, Step &entry) {
+        const auto &scale = *params.scale;
+        int note = step.note() + (scale.isChromatic() ? params.rootNote : 0) + params.octave * scale.notesPerOctave() + params.transpose;
+        int length = NoteSequence::Length::clamp(step.length() + params.lengthBias) + 1;
+        entry.volts = scale.noteToVolts(note);
+        entry.note = note;
+        entry.gateOffset = (params.divisor * step.gateOffset()) / (NoteSequence::GateOffset::Max + 1);
+        entry.gateLength = (params.divisor * length) / NoteSequence::Length::Range;
+    }
+
+private:
+    static_assert(CONFIG_STEP_COUNT <= 64, "step mask does not fit");
+
+    // step data affecting the compiled step
+    static uint16_t stepKey(const NoteSequence::Step &step) {
+        return
+            (step.note() & 0x7f) |
+            (step.length() << 7) |
+            ((step.gateOffset() & 0xf) << 10);
+    }
+
+    Params _params;
+    uint64_t _valid;
+    std::array<Step, CONFIG_STEP_COUNT> _steps;
+};
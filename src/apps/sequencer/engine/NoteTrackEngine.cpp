@@ -10,10 +10,8 @@
 
 #include "model/Scale.h"
 
-static Random rng;
-
 // evaluate if step gate is active
-static bool evalStepGate(const NoteSequence::Step &step, int probabilityBias) {
+static bool evalStepGate(Random &rng, const NoteSequence::Step &step, int probabilityBias) {
     int probability = clamp(step.gateProbability() + probabilityBias, -1, NoteSequence::GateProbability::Max);
     return step.gate() && int(rng.nextRange(NoteSequence::GateProbability::Range)) <= probability;
 }
@@ -41,23 +39,24 @@ static bool evalStepCondition(const NoteSequence::Step &step, int iteration, boo
 }
 
 // evaluate step retrigger count
-static int evalStepRetrigger(const NoteSequence::Step &step, int probabilityBias) {
+static int evalStepRetrigger(Random &rng, const NoteSequence::Step &step, int probabilityBias) {
     int probability = clamp(step.retriggerProbability() + probabilityBias, -1, NoteSequence::RetriggerProbability::Max);
     return int(rng.nextRange(NoteSequence::RetriggerProbability::Range)) <= probability ? step.retrigger() + 1 : 1;
 }
 
-// evaluate step length
-static int evalStepLength(const NoteSequence::Step &step, int lengthBias) {
-    int length = NoteSequence::Length::clamp(step.length() + lengthBias) + 1;
+// evaluate step length in ticks
+static uint32_t evalStepLength(Random &rng, const NoteSequence::Step &step, const NotePlayPlan::Step &planStep, int lengthBias, uint32_t divisor) {
     int probability = step.lengthVariationProbability();
     if (int(rng.nextRange(NoteSequence::LengthVariationProbability::Range)) <= probability) {
+        int length = NoteSequence::Length::clamp(step.length() + lengthBias) + 1;
         int offset = step.lengthVariationRange() == 0 ? 0 : rng.nextRange(std::abs(step.lengthVariationRange()) + 1);
         if (step.lengthVariationRange() < 0) {
             offset = -offset;
         }
         length = clamp(length + offset, 0, NoteSequence::Length::Range);
+        return (divisor * length) / NoteSequence::Length::Range;
     }
-    return length;
+    return planStep.gateLength;
 }
 
 // evaluate transposition
@@ -66,17 +65,19 @@ static int evalTransposition(const Scale &scale, int octave, int transpose) {
 }
 
 // evaluate note voltage
-static float evalStepNote(const NoteSequence::Step &step, int probabilityBias, const Scale &scale, int rootNote, int octave, int transpose, bool useVariation = true) {
-    int note = step.note() + (scale.isChromatic() ? rootNote : 0) + evalTransposition(scale, octave, transpose);
+static float evalStepNote(Random &rng, const NoteSequence::Step &step, const NotePlayPlan::Step &planStep, int probabilityBias, const Scale &scale) {
     int probability = clamp(step.noteVariationProbability() + probabilityBias, -1, NoteSequence::NoteVariationProbability::Max);
-    if (useVariation && int(rng.nextRange(NoteSequence::NoteVariationProbability::Range)) <= probability) {
+    if (int(rng.nextRange(NoteSequence::NoteVariationProbability::Range)) <= probability) {
         int offset = step.noteVariationRange() == 0 ? 0 : rng.nextRange(std::abs(step.noteVariationRange()) + 1);
         if (step.noteVariationRange() < 0) {
             offset = -offset;
         }
-        note = NoteSequence::Note::clamp(note + offset);
+        int note = NoteSequence::Note::clamp(planStep.note + offset);
+        if (note != planStep.note) {
+            return scale.noteToVolts(note);
+        }
     }
-    return scale.noteToVolts(note);
+    return planStep.volts;
 }
 
 void NoteTrackEngine::reset() {
@@ -129,7 +130,7 @@ void NoteTrackEngine::tick(uint32_t tick) {
         switch (_noteTrack.playMode()) {
         case Types::PlayMode::Aligned:
             if (relativeTick % divisor == 0) {
-                _sequenceState.advanceAligned(relativeTick / divisor, sequence.runMode(), sequence.firstStep(), sequence.lastStep(), rng);
+                _sequenceState.advanceAligned(relativeTick / divisor, sequence.runMode(), sequence.firstStep(), sequence.lastStep(), _rng);
                 recordStep(tick, divisor);
                 triggerStep(tick, divisor);
             }
@@ -140,7 +141,7 @@ void NoteTrackEngine::tick(uint32_t tick) {
                 _freeRelativeTick = 0;
             }
             if (relativeTick == 0) {
-                _sequenceState.advanceFree(sequence.runMode(), sequence.firstStep(), sequence.lastStep(), rng);
+                _sequenceState.advanceFree(sequence.runMode(), sequence.firstStep(), sequence.lastStep(), _rng);
                 recordStep(tick, divisor);
                 triggerStep(tick, divisor);
             }
@@ -181,10 +182,6 @@ void NoteTrackEngine::update(float dt) {
     bool recording = _engine.state().recording();
 
     const auto &sequence = *_sequence;
-    const auto &scale = sequence.selectedScale(_model.project().scale());
-    int rootNote = sequence.selectedRootNote(_model.project().rootNote());
-    int octave = _noteTrack.octave();
-    int transpose = _noteTrack.transpose();
 
     // enable/disable step recording mode
     if (_engine.recording() && _model.project().recordMode() == Types::RecordMode::StepRecord) {
@@ -199,13 +196,15 @@ void NoteTrackEngine::update(float dt) {
     bool isStepRecordMode = _model.project().recordMode() == Types::RecordMode::StepRecord;
     if (!running && (!recording || isStepRecordMode) && _monitorStepIndex >= 0) {
         // step monitoring (first priority)
-        const auto &step = sequence.step(_monitorStepIndex);
-        _cvOutputTarget = evalStepNote(step, 0, scale, rootNote, octave, transpose, false);
+        NotePlayPlan::Step planStep;
+        NotePlayPlan::compile(playPlanParams(sequence, 0), sequence.step(_monitorStepIndex), planStep);
+        _cvOutputTarget = planStep.volts;
         _activity = _gateOutput = true;
         _monitorOverrideActive = true;
     } else if ((!running || !isStepRecordMode) && _recordHistory.isNoteActive()) {
         // midi monitoring (second priority)
-        int note = noteFromMidiNote(_recordHistory.activeNote()) + evalTransposition(scale, octave, transpose);
+        const auto &scale = _model.project().selectedScale(sequence);
+        int note = noteFromMidiNote(_recordHistory.activeNote()) + evalTransposition(scale, _noteTrack.octave(), _noteTrack.transpose());
         _cvOutputTarget = scale.noteToVolts(note);
         _activity = _gateOutput = true;
         _monitorOverrideActive = true;
@@ -224,7 +223,11 @@ void NoteTrackEngine::update(float dt) {
 }
 
 void NoteTrackEngine::changePattern() {
-    _sequence = &_noteTrack.sequence(pattern());
+    auto sequence = &_noteTrack.sequence(pattern());
+    if (sequence != _sequence) {
+        _sequence = sequence;
+        _playPlan.invalidate();
+    }
     _fillSequence = &_noteTrack.sequence(std::min(pattern() + 1, CONFIG_PATTERN_COUNT - 1));
 }
 
@@ -258,10 +261,8 @@ void NoteTrackEngine::setMonitorStep(int index) {
 }
 
 void NoteTrackEngine::triggerStep(uint32_t tick, uint32_t divisor) {
-    int octave = _noteTrack.octave();
-    int transpose = _noteTrack.transpose();
     int rotate = _noteTrack.rotate();
-    bool fillStep = fill() && (rng.nextRange(100) < uint32_t(fillAmount()));
+    bool fillStep = fill() && (_rng.nextRange(100) < uint32_t(fillAmount()));
     bool useFillGates = fillStep && _noteTrack.fillMode() == NoteTrack::FillMode::Gates;
     bool useFillSequence = fillStep && _noteTrack.fillMode() == NoteTrack::FillMode::NextPattern;
     bool useFillCondition = fillStep && _noteTrack.fillMode() == NoteTrack::FillMode::Condition;
@@ -270,17 +271,29 @@ void NoteTrackEngine::triggerStep(uint32_t tick, uint32_t divisor) {
     const auto &evalSequence = useFillSequence ? *_fillSequence : *_sequence;
     _currentStep = SequenceUtils::rotateStep(_sequenceState.step(), sequence.firstStep(), sequence.lastStep(), rotate);
     const auto &step = evalSequence.step(_currentStep);
+    const auto &scale = _model.project().selectedScale(evalSequence);
+
+    // steps of the fill sequence are compiled on the fly to keep the play plan of the active sequence
+    auto params = playPlanParams(evalSequence, divisor);
+    NotePlayPlan::Step fillPlanStep;
+    const NotePlayPlan::Step *planStep = &fillPlanStep;
+    if (useFillSequence) {
+        NotePlayPlan::compile(params, step, fillPlanStep);
+    } else {
+        _playPlan.setParams(params);
+        planStep = &_playPlan.step(_currentStep, step);
+    }
 
-    uint32_t gateOffset = (divisor * step.gateOffset()) / (NoteSequence::GateOffset::Max + 1);
+    uint32_t gateOffset = planStep->gateOffset;
 
-    bool stepGate = evalStepGate(step, _noteTrack.gateProbabilityBias()) || useFillGates;
+    bool stepGate = evalStepGate(_rng, step, _noteTrack.gateProbabilityBias()) || useFillGates;
     if (stepGate) {
         stepGate = evalStepCondition(step, _sequenceState.iteration(), useFillCondition, _prevCondition);
     }
 
     if (stepGate) {
-        uint32_t stepLength = (divisor * evalStepLength(step, _noteTrack.lengthBias())) / NoteSequence::Length::Range;
-        int stepRetrigger = evalStepRetrigger(step, _noteTrack.retriggerProbabilityBias());
+        uint32_t stepLength = evalStepLength(_rng, step, *planStep, _noteTrack.lengthBias(), divisor);
+        int stepRetrigger = evalStepRetrigger(_rng, step, _noteTrack.retriggerProbabilityBias());
         if (stepRetrigger > 1) {
             uint32_t retriggerLength = divisor / stepRetrigger;
             uint32_t retriggerOffset = 0;
@@ -296,9 +309,7 @@ void NoteTrackEngine::triggerStep(uint32_t tick, uint32_t divisor) {
     }
 
     if (stepGate || _noteTrack.cvUpdateMode() == NoteTrack::CvUpdateMode::Always) {
-        const auto &scale = evalSequence.selectedScale(_model.project().scale());
-        int rootNote = evalSequence.selectedRootNote(_model.project().rootNote());
-        _cvQueue.push({ Groove::applySwing(tick + gateOffset, swing()), evalStepNote(step, _noteTrack.noteProbabilityBias(), scale, rootNote, octave, transpose), step.slide() });
+        _cvQueue.push({ Groove::applySwing(tick + gateOffset, swing()), evalStepNote(_rng, step, *planStep, _noteTrack.noteProbabilityBias(), scale), step.slide() });
     }
 }
 
@@ -371,7 +382,7 @@ void NoteTrackEngine::recordStep(uint32_t tick, uint32_t divisor) {
 }
 
 int NoteTrackEngine::noteFromMidiNote(uint8_t midiNote) const {
-    const auto &scale = _sequence->selectedScale(_model.project().scale());
+    const auto &scale = _model.project().selectedScale(*_sequence);
     int rootNote = _sequence->selectedRootNote(_model.project().rootNote());
 
     if (scale.isChromatic()) {
@@ -380,3 +391,16 @@ int NoteTrackEngine::noteFromMidiNote(uint8_t midiNote) const {
         return scale.noteFromVolts((midiNote - 60) * (1.f / 12.f));
     }
 }
+
+NotePlayPlan::Params NoteTrackEngine::playPlanParams(const NoteSequence &sequence, uint32_t divisor) const {
+    const auto &scale = _model.project().selectedScale(sequence);
+    return {
+        .scale = &scale,
+        .scaleRevision = scale.revision(),
+        .rootNote = sequence.selectedRootNote(_model.project().rootNote()),
+        .octave = _noteTrack.octave(),
+        .transpose = _noteTrack.transpose(),
+        .divisor = divisor,
+        .lengthBias = _noteTrack.lengthBias()
+    };
+}
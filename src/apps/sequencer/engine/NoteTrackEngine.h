@@ -2,7 +2,8 @@
 
 #include "TrackEngine.h"
 #include "SequenceState.h"
-#include "SortedQueue.h"
+#include "EventQueue.h"
+#include "NotePlayPlan.h"
 #include "Groove.h"
 #include "RecordHistory.h"
 
@@ -10,7 +11,8 @@ class NoteTrackEngine : public TrackEngine {
 public:
     NoteTrackEngine(Engine &engine, const Model &model, Track &track, const TrackEngine *linkedTrackEngine) :
         TrackEngine(engine, model, track, linkedTrackEngine),
-        _noteTrack(track.noteTrack())
+        _noteTrack(track.noteTrack()),
+        _rng(track.trackIndex())
     {
         reset();
     }
@@ -35,6 +37,8 @@ public:
         return _currentStep < 0 ? 0.f : float(_currentStep - _sequence->firstStep()) / (_sequence->lastStep() - _sequence->firstStep());
     }
 
+    virtual uint32_t eventQueueOverflows() const override { return _gateQueue.overflows() + _cvQueue.overflows(); }
+
     const NoteSequence &sequence() const { return *_sequence; }
     bool isActiveSequence(const NoteSequence &sequence) const { return &sequence == _sequence; }
 
@@ -47,15 +51,18 @@ private:
     void triggerStep(uint32_t tick, uint32_t divisor);
     void recordStep(uint32_t tick, uint32_t divisor);
     int noteFromMidiNote(uint8_t midiNote) const;
+    NotePlayPlan::Params playPlanParams(const NoteSequence &sequence, uint32_t divisor) const;
 
     NoteTrack &_noteTrack;
 
     TrackLinkData _linkData;
 
-    NoteSequence *_sequence;
+    NoteSequence *_sequence = nullptr;
     const NoteSequence *_fillSequence;
+    NotePlayPlan _playPlan;
 
     uint32_t _freeRelativeTick;
+    Random _rng;
     SequenceState _sequenceState;
     int _currentStep;
     bool _prevCondition;
@@ -83,7 +90,7 @@ private:
         }
     };
 
-    SortedQueue<Gate, 16, GateCompare> _gateQueue;
+    EventQueue<Gate, CONFIG_EVENT_QUEUE_SIZE, GateCompare> _gateQueue;
 
     struct Cv {
         uint32_t tick;
@@ -97,5 +104,5 @@ private:
         }
     };
 
-    SortedQueue<Cv, 16, CvCompare> _cvQueue;
+    EventQueue<Cv, CONFIG_EVENT_QUEUE_SIZE, CvCompare> _cvQueue;
 };
@@ -1,7 +1,10 @@
 #include "RoutingEngine.h"
 
 #include "Engine.h"
-#include "MidiUtils.h"
+
+#include <algorithm>
+
+#include <cstring>
 
 // for allowing direct mapping
 static_assert(int(MidiPort::Midi) == int(Types::MidiPort::Midi), "invalid mapping");
@@ -10,79 +13,158 @@ static_assert(int(MidiPort::UsbMidi) == int(Types::MidiPort::UsbMidi), "invalid
 RoutingEngine::RoutingEngine(Engine &engine, Model &model) :
     _engine(engine),
     _routing(model.project().routing())
-{}
+{
+    std::memset(&_midiIndex, 0, sizeof(_midiIndex));
+}
 
 void RoutingEngine::update() {
+    updateMidiIndex();
     updateSources();
     updateSinks();
 }
 
 bool RoutingEngine::receiveMidi(MidiPort port, const MidiMessage &message) {
+    if (size_t(port) >= size_t(Types::MidiPort::Last)) {
+        return false;
+    }
+
+    RouteMask routes = 0;
+    if (message.isControlChange()) {
+        routes = _midiIndex.controls[message.controlNumber()];
+    } else if (message.isNoteOn() || message.isNoteOff()) {
+        routes = _midiIndex.notes[message.note()];
+    } else if (message.isPitchBend()) {
+        routes = _midiIndex.pitchBend;
+    }
+    routes &= _midiIndex.channels[size_t(port)][message.channel()];
+
     bool consumed = false;
 
+    for (int routeIndex = 0; routes; ++routeIndex, routes >>= 1) {
+        if (routes & 1) {
+            consumed |= receiveMidi(routeIndex, message);
+        }
+    }
+
+    return consumed;
+}
+
+bool RoutingEngine::receiveMidi(int routeIndex, const MidiMessage &message) {
+    bool consumed = false;
+
+    // port, channel, control number and note are already matched by the dispatch index
+    const auto &midiSource = _routeStates[routeIndex].midiSource;
+    auto &sourceValue = _sourceValues[routeIndex];
+    switch (midiSource.event()) {
+    case Routing::MidiSource::Event::ControlAbsolute:
+        sourceValue = message.controlValue() * (1.f / 127.f);
+        consumed = true;
+        break;
+    case Routing::MidiSource::Event::ControlRelative: {
+        int value = message.controlValue();
+        value = value >= 64 ? 64 - value : value;
+        sourceValue = clamp(sourceValue + value * (1.f / 127.f), 0.f, 1.f);
+        consumed = true;
+        break;
+    }
+    case Routing::MidiSource::Event::PitchBend:
+        sourceValue = (message.pitchBend() + 0x2000) * (1.f / 16383.f);
+        consumed = true;
+        break;
+    case Routing::MidiSource::Event::NoteMomentary:
+        if (message.isNoteOn()) {
+            sourceValue = 1.f;
+            consumed = true;
+        } else if (message.isNoteOff()) {
+            sourceValue = 0.f;
+            consumed = true;
+        }
+        break;
+    case Routing::MidiSource::Event::NoteToggle:
+        if (message.isNoteOn()) {
+            sourceValue = sourceValue < 0.5f ? 1.f : 0.f;
+            consumed = true;
+        }
+        break;
+    case Routing::MidiSource::Event::NoteVelocity:
+        if (message.isNoteOn()) {
+            sourceValue = message.velocity() * (1.f / 127.f);
+            consumed = true;
+        }
+        break;
+    case Routing::MidiSource::Event::NoteRange:
+        if (message.isNoteOn()) {
+            sourceValue = (message.note() - midiSource.note()) / float(midiSource.noteRange() - 1);
+            consumed = true;
+        }
+        break;
+    case Routing::MidiSource::Event::Last:
+        break;
+    }
+
+    return consumed;
+}
+
+void RoutingEngine::updateMidiIndex() {
+    bool changed = false;
+
     for (int routeIndex = 0; routeIndex < CONFIG_ROUTE_COUNT; ++routeIndex) {
         const auto &route = _routing.route(routeIndex);
-        if (route.active() &&
-            route.source() == Routing::Source::Midi &&
-            MidiUtils::matchSource(port, message, route.midiSource().source())
-        ) {
-            const auto &midiSource = route.midiSource();
-            auto &sourceValue = _sourceValues[routeIndex];
-            switch (midiSource.event()) {
-            case Routing::MidiSource::Event::ControlAbsolute:
-                if (message.controlNumber() == midiSource.controlNumber()) {
-                    sourceValue = message.controlValue() * (1.f / 127.f);
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::ControlRelative:
-                if (message.controlNumber() == midiSource.controlNumber()) {
-                    int value = message.controlValue();
-                    value = value >= 64 ? 64 - value : value;
-                    sourceValue = clamp(sourceValue + value * (1.f / 127.f), 0.f, 1.f);
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::PitchBend:
-                if (message.isPitchBend()) {
-                    sourceValue = (message.pitchBend() + 0x2000) * (1.f / 16383.f);
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::NoteMomentary:
-                if (message.isNoteOn() && message.note() == midiSource.note()) {
-                    sourceValue = 1.f;
-                    consumed = true;
-                } else if (message.isNoteOff() && message.note() == midiSource.note()) {
-                    sourceValue = 0.f;
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::NoteToggle:
-                if (message.isNoteOn() && message.note() == midiSource.note()) {
-                    sourceValue = sourceValue < 0.5f ? 1.f : 0.f;
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::NoteVelocity:
-                if (message.isNoteOn() && message.note() == midiSource.note()) {
-                    sourceValue = message.velocity() * (1.f / 127.f);
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::NoteRange:
-                if (message.isNoteOn() && message.note() >= midiSource.note() && message.note() < midiSource.note() + midiSource.noteRange()) {
-                    sourceValue = (message.note() - midiSource.note()) / float(midiSource.noteRange() - 1);
-                    consumed = true;
-                }
-                break;
-            case Routing::MidiSource::Event::Last:
-                break;
-            }
+        auto &routeState = _routeStates[routeIndex];
+        bool midi = route.active() && route.source() == Routing::Source::Midi;
+        if (midi != routeState.midi || (midi && !(route.midiSource() == routeState.midiSource))) {
+            routeState.midi = midi;
+            routeState.midiSource = route.midiSource();
+            changed = true;
         }
     }
 
-    return consumed;
+    if (!changed) {
+        return;
+    }
+
+    std::memset(&_midiIndex, 0, sizeof(_midiIndex));
+
+    for (int routeIndex = 0; routeIndex < CONFIG_ROUTE_COUNT; ++routeIndex) {
+        const auto &routeState = _routeStates[routeIndex];
+        if (!routeState.midi) {
+            continue;
+        }
+
+        const auto &midiSource = routeState.midiSource;
+        RouteMask routeBit = 1 << routeIndex;
+
+        // port & channel
+        auto &channels = _midiIndex.channels[size_t(midiSource.source().port())];
+        for (int channel = 0; channel < 16; ++channel) {
+            if (midiSource.source().isOmni() || channel == midiSource.source().channel()) {
+                channels[channel] |= routeBit;
+            }
+        }
+
+        // message
+        switch (midiSource.event()) {
+        case Routing::MidiSource::Event::ControlAbsolute:
+        case Routing::MidiSource::Event::ControlRelative:
+            _midiIndex.controls[midiSource.controlNumber()] |= routeBit;
+            break;
+        case Routing::MidiSource::Event::PitchBend:
+            _midiIndex.pitchBend |= routeBit;
+            break;
+        case Routing::MidiSource::Event::NoteMomentary:
+        case Routing::MidiSource::Event::NoteToggle:
+        case Routing::MidiSource::Event::NoteVelocity:
+            _midiIndex.notes[midiSource.note()] |= routeBit;
+            break;
+        case Routing::MidiSource::Event::NoteRange:
+            for (int note = midiSource.note(); note < std::min(128, midiSource.note() + midiSource.noteRange()); ++note) {
+                _midiIndex.notes[note] |= routeBit;
+            }
+            break;
+        case Routing::MidiSource::Event::Last:
+            break;
+        }
+    }
 }
 
 void RoutingEngine::updateSources() {
@@ -135,7 +217,7 @@ void RoutingEngine::updateSinks() {
 
         if (routeChanged) {
             // disable previous routing
-            Routing::setRouted(routeState.target, routeState.tracks, false);
+            _routing.setRouted(routeState.target, routeState.tracks, false);
         }
 
         if (route.active()) {
@@ -150,7 +232,7 @@ void RoutingEngine::updateSinks() {
 
         if (routeChanged) {
             // enable new routing
-            Routing::setRouted(route.target(), route.tracks(), true);
+            _routing.setRouted(route.target(), route.tracks(), true);
             // save state
             routeState.target = route.target();
             routeState.tracks = route.tracks();
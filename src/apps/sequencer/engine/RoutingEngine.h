@@ -23,9 +23,15 @@ public:
     bool receiveMidi(MidiPort port, const MidiMessage &message);
 
 private:
+    typedef uint16_t RouteMask;
+    static_assert(CONFIG_ROUTE_COUNT <= 16, "route mask does not fit");
+
+    void updateMidiIndex();
     void updateSources();
     void updateSinks();
 
+    bool receiveMidi(int routeIndex, const MidiMessage &message);
+
     void writeEngineTarget(Routing::Target target, float normalized);
 
     Engine &_engine;
@@ -36,7 +42,19 @@ private:
     struct RouteState {
         Routing::Target target = Routing::Target::None;
         uint8_t tracks = 0;
+        bool midi = false;
+        Routing::MidiSource midiSource;
     };
 
     std::array<RouteState, CONFIG_ROUTE_COUNT> _routeStates;
+
+    // dispatch index for midi routes, each entry is the set of routes that can match a message
+    struct MidiIndex {
+        std::array<std::array<RouteMask, 16>, size_t(Types::MidiPort::Last)> channels;
+        std::array<RouteMask, 128> controls;
+        std::array<RouteMask, 128> notes;
+        RouteMask pitchBend;
+    };
+
+    MidiIndex _midiIndex;
 };
@@ -3,6 +3,8 @@
 #include "core/Debug.h"
 #include "core/math/Math.h"
 
+#include <algorithm>
+
 static int randomStep(int firstStep, int lastStep, Random &rng) {
     return rng.nextRange(lastStep - firstStep + 1) + firstStep;
 }
@@ -107,11 +109,14 @@ void SequenceState::advanceAligned(int absoluteStep, Types::RunMode runMode, int
         absoluteStep %= (2 * stepCount);
         _step = (absoluteStep < stepCount) ? (firstStep + absoluteStep) : (lastStep - (absoluteStep - stepCount));
         break;
-    case Types::RunMode::PingPong:
-        _iteration = absoluteStep / (2 * stepCount - 2);
-        absoluteStep %= (2 * stepCount - 2);
+    case Types::RunMode::PingPong: {
+        // single step sequences have a period of one step
+        int period = std::max(1, 2 * stepCount - 2);
+        _iteration = absoluteStep / period;
+        absoluteStep %= period;
         _step = (absoluteStep < stepCount) ? (firstStep + absoluteStep) : (lastStep - (absoluteStep - stepCount) - 1);
         break;
+    }
     case Types::RunMode::Random:
         _step = firstStep + rng.nextRange(stepCount);
         break;
@@ -79,6 +79,10 @@ public:
 
     virtual float sequenceProgress() const { return -1.f; }
 
+    // statistics
+
+    virtual uint32_t eventQueueOverflows() const { return 0; }
+
     // helpers
 
     bool isSelected() const { return _model.project().selectedTrackIndex() == _track.trackIndex(); }
@@ -4,6 +4,7 @@ void Calibration::CvOutput::clear() {
     for (size_t i = 0; i < _items.size(); ++i) {
         _items[i] = defaultItemValue(i);
     }
+    updateSegments();
 }
 
 void Calibration::CvOutput::write(WriteContext &context) const {
@@ -18,6 +19,7 @@ void Calibration::CvOutput::read(ReadContext &context) {
     for (size_t i = 0; i < _items.size(); ++i) {
         reader.read(_items[i]);
     }
+    updateSegments();
 }
 
 void Calibration::CvOutput::update() {
@@ -55,6 +57,16 @@ void Calibration::CvOutput::update() {
             setItem(index, defaultItemValue(index), false);
         }
     }
+
+    updateSegments();
+}
+
+void Calibration::CvOutput::updateSegments() {
+    for (int index = 0; index < ItemCount; ++index) {
+        auto &segment = _segments[index];
+        segment.offset = item(index);
+        segment.slope = index < ItemCount - 1 ? item(index + 1) - item(index) : 0;
+    }
 }
 
 
@@ -35,7 +35,6 @@ public:
         }
 
         const ItemArray &items() const { return _items; }
-              ItemArray &items()       { return _items; }
 
         int item(int index) const {
             return _items[index] & 0x7fff;
@@ -83,16 +82,20 @@ public:
             return clamp(int((volts - volts0) / (volts1 - volts0) * 32768), 0, 0x7fff);
         }
 
+        // interpolates between the calibration items using the precomputed segment table
         uint16_t voltsToValue(float volts) const {
+            return positionToValue(voltsToPosition(volts));
+        }
+
+        // fixed point position within the segment table (segment index and fraction)
+        static int32_t voltsToPosition(float volts) {
             volts = clamp(volts, float(MinVoltage), float(MaxVoltage));
-            float fIndex = (volts - MinVoltage) * ItemsPerVolt;
-            int index = std::floor(fIndex);
-            if (index < ItemCount - 1) {
-                float t = fIndex - index;
-                return lerp(t, item(index), item(index + 1));
-            } else {
-                return item(ItemCount - 1);
-            }
+            return int32_t((volts - MinVoltage) * (ItemsPerVolt << SegmentBits));
+        }
+
+        uint16_t positionToValue(int32_t position) const {
+            const auto &segment = _segments[position >> SegmentBits];
+            return segment.offset + ((segment.slope * (position & SegmentMask)) >> SegmentBits);
         }
 
         void clear();
@@ -101,9 +104,21 @@ public:
         void read(ReadContext &context);
 
     private:
+        // fractional bits of the fixed point position within a segment
+        static constexpr int SegmentBits = 15;
+        static constexpr int32_t SegmentMask = (1 << SegmentBits) - 1;
+
+        // linear segment between two items, the last segment only holds the last item
+        struct Segment {
+            int32_t offset;
+            int32_t slope;
+        };
+
         void update();
+        void updateSegments();
 
         ItemArray _items;
+        std::array<Segment, ItemCount> _segments;
     };
 
     typedef std::array<CvOutput, CONFIG_CV_OUTPUT_CHANNELS> CvOutputArray;
@@ -122,6 +137,19 @@ public:
     // Methods
     //----------------------------------------
 
+    // converts the voltages of all cv outputs to dac values
+    void cvOutputVoltsToValues(const std::array<float, CONFIG_CV_OUTPUT_CHANNELS> &volts, std::array<uint16_t, CONFIG_CV_OUTPUT_CHANNELS> &values) const {
+        // convert all channels to table positions first, this pass is branch free and can be vectorized
+        std::array<int32_t, CONFIG_CV_OUTPUT_CHANNELS> positions;
+        for (int i = 0; i < CONFIG_CV_OUTPUT_CHANNELS; ++i) {
+            positions[i] = CvOutput::voltsToPosition(volts[i]);
+        }
+        // then interpolate using the segment table of each channel
+        for (int i = 0; i < CONFIG_CV_OUTPUT_CHANNELS; ++i) {
+            values[i] = _cvOutputs[i].positionToValue(positions[i]);
+        }
+    }
+
     void clear();
 
     void write(WriteContext &context) const;
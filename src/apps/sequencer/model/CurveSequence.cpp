@@ -116,25 +116,6 @@ void CurveSequence::Step::read(ReadContext &context) {
     }
 }
 
-void CurveSequence::writeRouted(Routing::Target target, int intValue, float floatValue) {
-    switch (target) {
-    case Routing::Target::Divisor:
-        setDivisor(intValue, true);
-        break;
-    case Routing::Target::RunMode:
-        setRunMode(Types::RunMode(intValue), true);
-        break;
-    case Routing::Target::FirstStep:
-        setFirstStep(intValue, true);
-        break;
-    case Routing::Target::LastStep:
-        setLastStep(intValue, true);
-        break;
-    default:
-        break;
-    }
-}
-
 void CurveSequence::clear() {
     setRange(Types::VoltageRange::Bipolar5V);
     setDivisor(12);
@@ -183,11 +164,11 @@ void CurveSequence::duplicateSteps() {
 void CurveSequence::write(WriteContext &context) const {
     auto &writer = context.writer;
     writer.write(_range);
-    writer.write(_divisor.base);
+    writer.write(_divisor);
     writer.write(_resetMeasure);
-    writer.write(_runMode.base);
-    writer.write(_firstStep.base);
-    writer.write(_lastStep.base);
+    writer.write(_runMode);
+    writer.write(_firstStep);
+    writer.write(_lastStep);
 
     writeArray(context, _steps);
 }
@@ -196,14 +177,14 @@ void CurveSequence::read(ReadContext &context) {
     auto &reader = context.reader;
     reader.read(_range);
     if (reader.dataVersion() < ProjectVersion::Version10) {
-        reader.readAs<uint8_t>(_divisor.base);
+        reader.readAs<uint8_t>(_divisor);
     } else {
-        reader.read(_divisor.base);
+        reader.read(_divisor);
     }
     reader.read(_resetMeasure);
-    reader.read(_runMode.base);
-    reader.read(_firstStep.base);
-    reader.read(_lastStep.base);
+    reader.read(_runMode);
+    reader.read(_firstStep);
+    reader.read(_lastStep);
 
     readArray(context, _steps);
 }
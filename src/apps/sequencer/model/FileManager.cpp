@@ -1,5 +1,6 @@
 #include "FileManager.h"
 
+#include "core/profiler/Profiler.h"
 #include "core/utils/StringBuilder.h"
 
 #include "os/os.h"
@@ -8,15 +9,8 @@
 
 #include <cstring>
 
-uint32_t FileManager::_volumeState = 0;
-uint32_t FileManager::_nextVolumeStateCheckTicks = 0;
-
-std::array<FileManager::CachedSlotInfo, 4> FileManager::_cachedSlotInfos;
-uint32_t FileManager::_cachedSlotInfoTicket = 0;
-
-FileManager::TaskExecuteCallback FileManager::_taskExecuteCallback;
-FileManager::TaskResultCallback FileManager::_taskResultCallback;
-volatile uint32_t FileManager::_taskPending;
+PROFILER_INTERVAL(file_mount, "FileManager::mount")
+PROFILER_INTERVAL(file_task, "FileManager::task")
 
 struct FileTypeInfo {
     const char *dir;
@@ -33,13 +27,9 @@ static void slotPath(StringBuilder &str, FileType type, int slot) {
     str("%s/%03d.%s", info.dir, slot + 1, info.ext);
 }
 
-void FileManager::init() {
-    _volumeState = 0;
-    _nextVolumeStateCheckTicks = 0;
-    _taskExecuteCallback = nullptr;
-    _taskResultCallback = nullptr;
-    _taskPending = 0;
-}
+FileManager::FileManager(fs::Volume *volume) :
+    _volume(volume)
+{}
 
 bool FileManager::volumeAvailable() {
     return _volumeState & Available;
@@ -51,7 +41,7 @@ bool FileManager::volumeMounted() {
 
 fs::Error FileManager::format() {
     invalidateAllSlots();
-    return fs::volume().format();
+    return _volume ? _volume->format() : fs::NOT_READY;
 }
 
 fs::Error FileManager::saveProject(Project &project, int slot) {
@@ -130,10 +120,11 @@ bool FileManager::slotUsed(FileType type, int slot) {
     return info.used;
 }
 
-void FileManager::task(TaskExecuteCallback executeCallback, TaskResultCallback resultCallback) {
-    _taskExecuteCallback = executeCallback;
-    _taskResultCallback = resultCallback;
-    _taskPending = 1;
+FileManager::TaskId FileManager::task(TaskExecuteCallback executeCallback, TaskResultCallback resultCallback, TaskPriority priority) {
+    return _taskQueue.add([this, executeCallback] () {
+        PROFILER_INTERVAL_SCOPE(file_task);
+        return _volume ? executeCallback() : fs::NOT_READY;
+    }, resultCallback, priority);
 }
 
 void FileManager::processTask() {
@@ -142,10 +133,11 @@ void FileManager::processTask() {
     if (ticks >= _nextVolumeStateCheckTicks) {
         _nextVolumeStateCheckTicks = ticks + os::time::ms(1000);
 
-        uint32_t newVolumeState = fs::volume().available() ? Available : 0;
+        uint32_t newVolumeState = (_volume && _volume->available()) ? Available : 0;
         if (newVolumeState & Available) {
             if (!(_volumeState & Mounted)) {
-                newVolumeState |= (fs::volume().mount() == fs::OK) ? Mounted : 0;
+                PROFILER_INTERVAL_SCOPE(file_mount);
+                newVolumeState |= (_volume->mount() == fs::OK) ? Mounted : 0;
             } else {
                 newVolumeState |= Mounted;
             }
@@ -156,13 +148,12 @@ void FileManager::processTask() {
         _volumeState = newVolumeState;
     }
 
-    if (_taskPending) {
-        fs::Error result = _taskExecuteCallback();
-        _taskPending = 0;
-        _taskResultCallback(result);
-    }
+    _taskQueue.executeNext();
 }
 
+void FileManager::processTaskResults() {
+    _taskQueue.deliverResults();
+}
 
 fs::Error FileManager::saveFile(FileType type, int slot, std::function<fs::Error(const char *)> write) {
     const auto &info = fileTypeInfos[int(type)];
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "FileDefs.h"
+#include "FileTaskQueue.h"
 #include "Project.h"
 #include "UserScale.h"
 
@@ -13,19 +14,20 @@
 
 class FileManager {
 public:
-    static void init();
+    // volume is optional, all file operations fail if no volume is attached
+    FileManager(fs::Volume *volume);
 
-    static bool volumeAvailable();
-    static bool volumeMounted();
+    bool volumeAvailable();
+    bool volumeMounted();
 
-    static fs::Error format();
+    fs::Error format();
 
-    static fs::Error saveProject(Project &project, int slot);
-    static fs::Error loadProject(Project &project, int slot);
-    static fs::Error loadLastProject(Project &project);
+    fs::Error saveProject(Project &project, int slot);
+    fs::Error loadProject(Project &project, int slot);
+    fs::Error loadLastProject(Project &project);
 
-    static fs::Error saveUserScale(const UserScale &userScale, int slot);
-    static fs::Error loadUserScale(UserScale &userScale, int slot);
+    fs::Error saveUserScale(const UserScale &userScale, int slot);
+    fs::Error loadUserScale(UserScale &userScale, int slot);
 
     // Slot information
 
@@ -34,29 +36,45 @@ public:
         char name[FileHeader::NameLength + 1];
     };
 
-    static void slotInfo(FileType type, int slot, SlotInfo &info);
-    static bool slotUsed(FileType type, int slot);
+    void slotInfo(FileType type, int slot, SlotInfo &info);
+    bool slotUsed(FileType type, int slot);
 
-    // File tasks
+    // File tasks (see FileTaskQueue)
 
-    typedef std::function<fs::Error(void)> TaskExecuteCallback;
-    typedef std::function<void(fs::Error)> TaskResultCallback;
+    typedef FileTaskQueue::TaskId TaskId;
+    typedef FileTaskQueue::Priority TaskPriority;
+    typedef FileTaskQueue::ExecuteCallback TaskExecuteCallback;
+    typedef FileTaskQueue::ResultCallback TaskResultCallback;
 
-    static void task(TaskExecuteCallback executeCallback, TaskResultCallback resultCallback);
-    static void processTask();
+    // queues a task, returns 0 if the queue is full
+    TaskId task(TaskExecuteCallback executeCallback, TaskResultCallback resultCallback, TaskPriority priority = TaskPriority::Normal);
+    // removes a task that has not started yet, its result callback is not called
+    bool cancelTask(TaskId id) { return _taskQueue.cancel(id); }
+    // number of tasks that are queued, running or waiting for their result to be delivered
+    int pendingTasks() { return _taskQueue.pending(); }
+
+    // progress of the running task in the range [0..1] or -1 if unknown
+    float taskProgress() const { return _taskQueue.progress(); }
+    // called from the execute callback to report progress
+    void setTaskProgress(float progress) { _taskQueue.setProgress(progress); }
+
+    // executes the next queued task, called from the file task
+    void processTask();
+    // calls the result callbacks of completed tasks, called from the ui task
+    void processTaskResults();
 
 private:
-    static fs::Error saveFile(FileType type, int slot, std::function<fs::Error(const char *)> write);
-    static fs::Error loadFile(FileType type, int slot, std::function<fs::Error(const char *)> read);
+    fs::Error saveFile(FileType type, int slot, std::function<fs::Error(const char *)> write);
+    fs::Error loadFile(FileType type, int slot, std::function<fs::Error(const char *)> read);
 
-    static fs::Error saveLastProject(int slot);
-    static fs::Error loadLastProject(int &slot);
+    fs::Error saveLastProject(int slot);
+    fs::Error loadLastProject(int &slot);
 
-    static bool cachedSlot(FileType type, int slot, SlotInfo &info);
-    static void cacheSlot(FileType type, int slot, const SlotInfo &info);
-    static void invalidateSlot(FileType type, int slot);
-    static void invalidateAllSlots();
-    static uint32_t nextCachedSlotTicket();
+    bool cachedSlot(FileType type, int slot, SlotInfo &info);
+    void cacheSlot(FileType type, int slot, const SlotInfo &info);
+    void invalidateSlot(FileType type, int slot);
+    void invalidateAllSlots();
+    uint32_t nextCachedSlotTicket();
 
     struct CachedSlotInfo {
         uint32_t ticket = 0;
@@ -74,13 +92,13 @@ private:
         Mounted     = (1<<1),
     };
 
-    static uint32_t _volumeState;
-    static uint32_t _nextVolumeStateCheckTicks;
+    fs::Volume *_volume;
+
+    uint32_t _volumeState = 0;
+    uint32_t _nextVolumeStateCheckTicks = 0;
 
-    static std::array<CachedSlotInfo, 4> _cachedSlotInfos;
-    static uint32_t _cachedSlotInfoTicket;
+    std::array<CachedSlotInfo, 4> _cachedSlotInfos;
+    uint32_t _cachedSlotInfoTicket = 0;
 
-    static TaskExecuteCallback _taskExecuteCallback;
-    static TaskResultCallback _taskResultCallback;
-    static volatile uint32_t _taskPending;
+    FileTaskQueue _taskQueue;
 };
@@ -0,0 +1,107 @@
+#include "FileTaskQueue.h"
+
+#include "os/LockGuard.h"
+
+#include <algorithm>
+
+FileTaskQueue::TaskId FileTaskQueue::add(ExecuteCallback executeCallback, ResultCallback resultCallback, Priority priority) {
+    os::LockGuard lock(_mutex);
+
+    for (auto &task : _tasks) {
+        if (task.state == Task::State::Free) {
+            task.id = _nextId++;
+            if (_nextId == 0) {
+                _nextId = 1;
+            }
+            task.state = Task::State::Queued;
+            task.priority = priority;
+            task.order = _order++;
+            task.executeCallback = executeCallback;
+            task.resultCallback = resultCallback;
+            return task.id;
+        }
+    }
+
+    return 0;
+}
+
+bool FileTaskQueue::cancel(TaskId id) {
+    os::LockGuard lock(_mutex);
+
+    for (auto &task : _tasks) {
+        if (task.id == id && task.state == Task::State::Queued) {
+            task.state = Task::State::Free;
+            task.executeCallback = nullptr;
+            task.resultCallback = nullptr;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int FileTaskQueue::pending() {
+    os::LockGuard lock(_mutex);
+
+    return std::count_if(_tasks.begin(), _tasks.end(), [] (const Task &task) {
+        return task.state != Task::State::Free;
+    });
+}
+
+bool FileTaskQueue::executeNext() {
+    // pick the queued task with the highest priority
+    Task *next = nullptr;
+    {
+        os::LockGuard lock(_mutex);
+        for (auto &task : _tasks) {
+            if (task.state == Task::State::Queued &&
+                (!next || task.priority > next->priority || (task.priority == next->priority && int32_t(task.order - next->order) < 0))) {
+                next = &task;
+            }
+        }
+        if (!next) {
+            return false;
+        }
+        next->state = Task::State::Running;
+        _progress = -1.f;
+    }
+
+    // add() and cancel() leave running tasks alone, execute without holding the lock
+    next->result = next->executeCallback();
+    _progress = -1.f;
+
+    os::LockGuard lock(_mutex);
+    next->executeCallback = nullptr;
+    next->order = _order++;
+    next->state = Task::State::Done;
+    return true;
+}
+
+void FileTaskQueue::deliverResults() {
+    while (true) {
+        ResultCallback resultCallback;
+        fs::Error result;
+        {
+            // deliver in order of completion
+            os::LockGuard lock(_mutex);
+            Task *done = nullptr;
+            for (auto &task : _tasks) {
+                if (task.state == Task::State::Done && (!done || int32_t(task.order - done->order) < 0)) {
+                    done = &task;
+                }
+            }
+            if (!done) {
+                return;
+            }
+            resultCallback = done->resultCallback;
+            result = done->result;
+            done->resultCallback = nullptr;
+            done->state = Task::State::Free;
+        }
+
+        // callbacks may add new tasks
+        if (resultCallback) {
+            resultCallback(result);
+        }
+    }
+}
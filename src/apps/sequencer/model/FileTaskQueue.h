@@ -0,0 +1,72 @@
+#pragma once
+
+#include "core/fs/FileSystem.h"
+
+#include "os/os.h"
+
+#include <array>
+#include <functional>
+
+#include <cstdint>
+
+// Queue of file tasks used by the FileManager.
+// Tasks are added from the ui task and executed one at a time in the file task, highest
+// priority first and in order of submission otherwise. Results are delivered to the ui task.
+class FileTaskQueue {
+public:
+    static constexpr int Size = 8;
+
+    // 0 is never used as a task id
+    typedef uint32_t TaskId;
+
+    enum class Priority : uint8_t {
+        Low,
+        Normal,
+        High,
+    };
+
+    typedef std::function<fs::Error(void)> ExecuteCallback;
+    typedef std::function<void(fs::Error)> ResultCallback;
+
+    // adds a task, returns 0 if the queue is full
+    TaskId add(ExecuteCallback executeCallback, ResultCallback resultCallback, Priority priority = Priority::Normal);
+    // removes a task that has not started yet, its result callback is not called
+    bool cancel(TaskId id);
+    // number of tasks that are queued, running or waiting for their result to be delivered
+    int pending();
+
+    // progress of the running task in the range [0..1] or -1 if unknown
+    float progress() const { return _progress; }
+    // called from the execute callback to report progress
+    void setProgress(float progress) { _progress = progress; }
+
+    // executes the next queued task, returns false if there is none
+    bool executeNext();
+    // calls the result callbacks of executed tasks
+    void deliverResults();
+
+private:
+    struct Task {
+        enum class State : uint8_t {
+            Free,
+            Queued,
+            Running,
+            Done,
+        };
+
+        TaskId id = 0;
+        State state = State::Free;
+        Priority priority;
+        fs::Error result;
+        // submission order while queued, completion order when done
+        uint32_t order;
+        ExecuteCallback executeCallback;
+        ResultCallback resultCallback;
+    };
+
+    std::array<Task, Size> _tasks;
+    TaskId _nextId = 1;
+    uint32_t _order = 0;
+    os::Mutex _mutex;
+    volatile float _progress = -1.f;
+};
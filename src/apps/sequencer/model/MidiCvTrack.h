@@ -230,8 +230,8 @@ public:
     // Routing
     //----------------------------------------
 
-    inline bool isRouted(Routing::Target target) const { return Routing::isRouted(target, _trackIndex); }
-    inline void printRouted(StringBuilder &str, Routing::Target target) const { Routing::printRouted(str, target, _trackIndex); }
+    inline bool isRouted(Routing::Target target) const { return _routing && _routing->isRouted(target, _trackIndex); }
+    inline void printRouted(StringBuilder &str, Routing::Target target) const { if (_routing) _routing->printRouted(str, target, _trackIndex); }
     void writeRouted(Routing::Target target, int intValue, float floatValue);
 
     //----------------------------------------
@@ -253,6 +253,11 @@ private:
         _trackIndex = trackIndex;
     }
 
+    void setRouting(const Routing *routing) {
+        _routing = routing;
+    }
+
+    const Routing *_routing = nullptr;
     int8_t _trackIndex = -1;
     MidiSourceConfig _source;
     uint8_t _voices;
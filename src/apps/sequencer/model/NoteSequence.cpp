@@ -155,25 +155,6 @@ void NoteSequence::Step::read(ReadContext &context) {
     }
 }
 
-void NoteSequence::writeRouted(Routing::Target target, int intValue, float floatValue) {
-    switch (target) {
-    case Routing::Target::Divisor:
-        setDivisor(intValue, true);
-        break;
-    case Routing::Target::RunMode:
-        setRunMode(Types::RunMode(intValue), true);
-        break;
-    case Routing::Target::FirstStep:
-        setFirstStep(intValue, true);
-        break;
-    case Routing::Target::LastStep:
-        setLastStep(intValue, true);
-        break;
-    default:
-        break;
-    }
-}
-
 void NoteSequence::clear() {
     setScale(-1);
     setRootNote(-1);
@@ -233,11 +214,11 @@ void NoteSequence::write(WriteContext &context) const {
     auto &writer = context.writer;
     writer.write(_scale);
     writer.write(_rootNote);
-    writer.write(_divisor.base);
+    writer.write(_divisor);
     writer.write(_resetMeasure);
-    writer.write(_runMode.base);
-    writer.write(_firstStep.base);
-    writer.write(_lastStep.base);
+    writer.write(_runMode);
+    writer.write(_firstStep);
+    writer.write(_lastStep);
 
     writeArray(context, _steps);
 }
@@ -247,14 +228,14 @@ void NoteSequence::read(ReadContext &context) {
     reader.read(_scale);
     reader.read(_rootNote);
     if (reader.dataVersion() < ProjectVersion::Version10) {
-        reader.readAs<uint8_t>(_divisor.base);
+        reader.readAs<uint8_t>(_divisor);
     } else {
-        reader.read(_divisor.base);
+        reader.read(_divisor);
     }
     reader.read(_resetMeasure);
-    reader.read(_runMode.base);
-    reader.read(_firstStep.base);
-    reader.read(_lastStep.base);
+    reader.read(_runMode);
+    reader.read(_firstStep);
+    reader.read(_lastStep);
 
     readArray(context, _steps);
 }
@@ -249,10 +249,6 @@ public:
         str(scale() < 0 ? "Default" : Scale::name(scale()));
     }
 
-    const Scale &selectedScale(int defaultScale) const {
-        return Scale::get(scale() < 0 ? defaultScale : scale());
-    }
-
     // rootNote
 
     int rootNote() const { return _rootNote; }
@@ -283,9 +279,9 @@ public:
 
     // divisor
 
-    int divisor() const { return _divisor.get(isRouted(Routing::Target::Divisor)); }
-    void setDivisor(int divisor, bool routed = false) {
-        _divisor.set(ModelUtils::clampDivisor(divisor), routed);
+    int divisor() const { return routedValue(Routing::Target::Divisor, _divisor); }
+    void setDivisor(int divisor) {
+        _divisor = ModelUtils::clampDivisor(divisor);
     }
 
     int indexedDivisor() const { return ModelUtils::divisorToIndex(divisor()); }
@@ -328,9 +324,9 @@ public:
 
     // runMode
 
-    Types::RunMode runMode() const { return _runMode.get(isRouted(Routing::Target::RunMode)); }
-    void setRunMode(Types::RunMode runMode, bool routed = false) {
-        _runMode.set(ModelUtils::clampedEnum(runMode), routed);
+    Types::RunMode runMode() const { return Types::RunMode(routedValue(Routing::Target::RunMode, int(_runMode))); }
+    void setRunMode(Types::RunMode runMode) {
+        _runMode = ModelUtils::clampedEnum(runMode);
     }
 
     void editRunMode(int value, bool shift) {
@@ -347,11 +343,14 @@ public:
     // firstStep
 
     int firstStep() const {
-        return _firstStep.get(isRouted(Routing::Target::FirstStep));
+        if (isRouted(Routing::Target::FirstStep)) {
+            return std::min(_routing->routedSequenceValue(Routing::Target::FirstStep, _trackIndex), routedValue(Routing::Target::LastStep, _lastStep));
+        }
+        return _firstStep;
     }
 
-    void setFirstStep(int firstStep, bool routed = false) {
-        _firstStep.set(clamp(firstStep, 0, lastStep()), routed);
+    void setFirstStep(int firstStep) {
+        _firstStep = clamp(firstStep, 0, lastStep());
     }
 
     void editFirstStep(int value, bool shift) {
@@ -371,11 +370,11 @@ public:
 
     int lastStep() const {
         // make sure last step is always >= first step even if stored value is invalid (due to routing changes)
-        return std::max(firstStep(), int(_lastStep.get(isRouted(Routing::Target::LastStep))));
+        return std::max(firstStep(), routedValue(Routing::Target::LastStep, _lastStep));
     }
 
-    void setLastStep(int lastStep, bool routed = false) {
-        _lastStep.set(clamp(lastStep, firstStep(), CONFIG_STEP_COUNT - 1), routed);
+    void setLastStep(int lastStep) {
+        _lastStep = clamp(lastStep, firstStep(), CONFIG_STEP_COUNT - 1);
     }
 
     void editLastStep(int value, bool shift) {
@@ -403,9 +402,13 @@ public:
     // Routing
     //----------------------------------------
 
-    inline bool isRouted(Routing::Target target) const { return Routing::isRouted(target, _trackIndex); }
-    inline void printRouted(StringBuilder &str, Routing::Target target) const { Routing::printRouted(str, target, _trackIndex); }
-    void writeRouted(Routing::Target target, int intValue, float floatValue);
+    inline bool isRouted(Routing::Target target) const { return _routing && _routing->isRouted(target, _trackIndex); }
+    inline void printRouted(StringBuilder &str, Routing::Target target) const { if (_routing) _routing->printRouted(str, target, _trackIndex); }
+
+    // routed values are stored once per track in the routing and shared by all patterns
+    inline int routedValue(Routing::Target target, int value) const {
+        return isRouted(target) ? _routing->routedSequenceValue(target, _trackIndex) : value;
+    }
 
     //----------------------------------------
     // Methods
@@ -430,6 +433,7 @@ public:
 
 private:
     void setTrackIndex(int trackIndex) { _trackIndex = trackIndex; }
+    void setRouting(const Routing *routing) { _routing = routing; }
 
     void offsetFirstAndLastStep(int value) {
         value = clamp(value, -firstStep(), CONFIG_STEP_COUNT - 1 - lastStep());
@@ -442,14 +446,15 @@ private:
         }
     }
 
+    const Routing *_routing = nullptr;
     int8_t _trackIndex = -1;
     int8_t _scale;
     int8_t _rootNote;
-    Routable<uint16_t> _divisor;
+    uint16_t _divisor;
     uint8_t _resetMeasure;
-    Routable<Types::RunMode> _runMode;
-    Routable<uint8_t> _firstStep;
-    Routable<uint8_t> _lastStep;
+    Types::RunMode _runMode;
+    uint8_t _firstStep;
+    uint8_t _lastStep;
 
     StepArray _steps;
 
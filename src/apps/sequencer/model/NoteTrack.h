@@ -257,8 +257,8 @@ public:
     // Routing
     //----------------------------------------
 
-    inline bool isRouted(Routing::Target target) const { return Routing::isRouted(target, _trackIndex); }
-    inline void printRouted(StringBuilder &str, Routing::Target target) const { Routing::printRouted(str, target, _trackIndex); }
+    inline bool isRouted(Routing::Target target) const { return _routing && _routing->isRouted(target, _trackIndex); }
+    inline void printRouted(StringBuilder &str, Routing::Target target) const { if (_routing) _routing->printRouted(str, target, _trackIndex); }
     void writeRouted(Routing::Target target, int intValue, float floatValue);
 
     //----------------------------------------
@@ -280,6 +280,14 @@ private:
         }
     }
 
+    void setRouting(const Routing *routing) {
+        _routing = routing;
+        for (auto &sequence : _sequences) {
+            sequence.setRouting(routing);
+        }
+    }
+
+    const Routing *_routing = nullptr;
     int8_t _trackIndex = -1;
     Types::PlayMode _playMode;
     FillMode _fillMode;
@@ -300,6 +300,9 @@ public:
     bool hasSyncedRequests() const { return _hasSyncedRequests; }
     bool hasLatchedRequests() const { return _hasLatchedRequests; }
 
+    // set when there are requests to be handled by the engine
+    bool isDirty() const { return _hasImmediateRequests || _hasSyncedRequests || _executeLatchedRequests; }
+
     // song
 
     void playSong(int slot, ExecuteType executeType = Immediate);
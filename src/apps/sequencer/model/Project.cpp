@@ -10,6 +10,7 @@ Project::Project() :
 {
     for (size_t i = 0; i < _tracks.size(); ++i) {
         _tracks[i].setTrackIndex(i);
+        _tracks[i].setRouting(&_routing);
     }
 
     clear();
@@ -57,7 +58,7 @@ void Project::clear() {
     _routing.clear();
     _midiOutput.clear();
 
-    for (auto &userScale : UserScale::userScales) {
+    for (auto &userScale : _userScales) {
         userScale.clear();
     }
 
@@ -123,7 +124,7 @@ void Project::write(WriteContext &context) const {
     _routing.write(context);
     _midiOutput.write(context);
 
-    writeArray(context, UserScale::userScales);
+    writeArray(context, _userScales);
 
     writer.write(_selectedTrackIndex);
     writer.write(_selectedPatternIndex);
@@ -142,6 +143,7 @@ bool Project::read(ReadContext &context) {
         _timeSignature.read(context);
     }
     reader.read(_syncMeasure);
+    _dirty = true;
     reader.read(_scale);
     reader.read(_rootNote);
     reader.read(_recordMode);
@@ -160,7 +162,7 @@ bool Project::read(ReadContext &context) {
     _midiOutput.read(context);
 
     if (reader.dataVersion() >= ProjectVersion::Version5) {
-        readArray(context, UserScale::userScales);
+        readArray(context, _userScales);
     }
 
     reader.read(_selectedTrackIndex);
@@ -94,10 +94,12 @@ public:
     TimeSignature timeSignature() const { return _timeSignature; }
     void setTimeSignature(TimeSignature timeSignature) {
         _timeSignature = timeSignature;
+        _dirty = true;
     }
 
     void editTimeSignature(int value, bool shift) {
         _timeSignature.edit(value, shift);
+        _dirty = true;
     }
 
     void printTimeSignature(StringBuilder &str) const {
@@ -109,6 +111,7 @@ public:
     int syncMeasure() const { return _syncMeasure; }
     void setSyncMeasure(int syncMeasure) {
         _syncMeasure = clamp(syncMeasure, 1, 128);
+        _dirty = true;
     }
 
     void editSyncMeasure(int value, bool shift) {
@@ -135,7 +138,16 @@ public:
     }
 
     const Scale &selectedScale() const {
-        return Scale::get(scale());
+        return scale(scale());
+    }
+
+    const Scale &selectedScale(const NoteSequence &sequence) const {
+        return scale(sequence.scale() < 0 ? scale() : sequence.scale());
+    }
+
+    // resolves a scale index to a builtin scale or one of the user scales
+    const Scale &scale(int index) const {
+        return index < Scale::BuiltinCount ? Scale::get(index) : _userScales[index - Scale::BuiltinCount];
     }
 
     // rootNote
@@ -249,11 +261,11 @@ public:
 
     // userScales
 
-    const UserScale::Array &userScales() const { return UserScale::userScales; }
-          UserScale::Array &userScales()       { return UserScale::userScales; }
+    const UserScale::Array &userScales() const { return _userScales; }
+          UserScale::Array &userScales()       { return _userScales; }
 
-    const UserScale &userScale(int index) const { return UserScale::userScales[index]; }
-          UserScale &userScale(int index)       { return UserScale::userScales[index]; }
+    const UserScale &userScale(int index) const { return _userScales[index]; }
+          UserScale &userScale(int index)       { return _userScales[index]; }
 
     // routing
 
@@ -337,8 +349,8 @@ public:
     // Routing
     //----------------------------------------
 
-    inline bool isRouted(Routing::Target target) const { return Routing::isRouted(target); }
-    inline void printRouted(StringBuilder &str, Routing::Target target) const { Routing::printRouted(str, target); }
+    inline bool isRouted(Routing::Target target) const { return _routing.isRouted(target); }
+    inline void printRouted(StringBuilder &str, Routing::Target target) const { _routing.printRouted(str, target); }
     void writeRouted(Routing::Target target, int intValue, float floatValue);
 
     //----------------------------------------
@@ -372,6 +384,10 @@ public:
     fs::Error write(const char *path) const;
     fs::Error read(const char *path);
 
+    // set when the time signature or sync measure changed
+    bool isDirty() const { return _dirty; }
+    void clearDirty() { _dirty = false; }
+
 private:
     uint8_t _slot = uint8_t(-1);
     char _name[NameLength + 1];
@@ -393,11 +409,14 @@ private:
     PlayState _playState;
     Routing _routing;
     MidiOutput _midiOutput;
+    UserScale::Array _userScales;
 
     int _selectedTrackIndex = 0;
     int _selectedPatternIndex = 0;
     NoteSequence::Layer _selectedNoteSequenceLayer = NoteSequence::Layer(0);
     CurveSequence::Layer _selectedCurveSequenceLayer = CurveSequence::Layer(0);
 
+    bool _dirty = true;
+
     Observable<Event, 2> _observable;
 };
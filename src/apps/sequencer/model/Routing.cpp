@@ -135,6 +135,8 @@ void Routing::clear() {
     for (auto &route : _routes) {
         route.clear();
     }
+
+    clearRouted();
 }
 
 int Routing::findEmptyRoute() const {
@@ -181,39 +183,27 @@ void Routing::writeTarget(Target target, uint8_t tracks, float normalized) {
         _project.writeRouted(target, intValue, floatValue);
     } else if (isPlayStateTarget(target)) {
         _project.playState().writeRouted(target, tracks, intValue, floatValue);
-    } else if (isTrackTarget(target) || isSequenceTarget(target)) {
+    } else if (isTrackTarget(target)) {
         for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
             if (tracks & (1<<trackIndex)) {
                 auto &track = _project.track(trackIndex);
                 switch (track.trackMode()) {
                 case Track::TrackMode::Note:
-                    if (isTrackTarget(target)) {
-                        track.noteTrack().writeRouted(target, intValue, floatValue);
-                    } else {
-                        for (int patternIndex = 0; patternIndex < CONFIG_PATTERN_COUNT; ++patternIndex) {
-                            track.noteTrack().sequence(patternIndex).writeRouted(target, intValue, floatValue);
-                        }
-                    }
+                    track.noteTrack().writeRouted(target, intValue, floatValue);
                     break;
                 case Track::TrackMode::Curve:
-                    if (isTrackTarget(target)) {
-                        track.curveTrack().writeRouted(target, intValue, floatValue);
-                    } else {
-                        for (int patternIndex = 0; patternIndex < CONFIG_PATTERN_COUNT; ++patternIndex) {
-                            track.curveTrack().sequence(patternIndex).writeRouted(target, intValue, floatValue);
-                        }
-                    }
+                    track.curveTrack().writeRouted(target, intValue, floatValue);
                     break;
                 case Track::TrackMode::MidiCv:
-                    if (isTrackTarget(target)) {
-                        track.midiCvTrack().writeRouted(target, intValue, floatValue);
-                    }
+                    track.midiCvTrack().writeRouted(target, intValue, floatValue);
                     break;
                 case Track::TrackMode::Last:
                     break;
                 }
             }
         }
+    } else if (isSequenceTarget(target)) {
+        writeRoutedSequenceValue(target, tracks, intValue);
     }
 }
 
@@ -223,19 +213,17 @@ void Routing::write(WriteContext &context) const {
 
 void Routing::read(ReadContext &context) {
     readArray(context, _routes);
+    clearRouted();
 }
 
-static std::array<uint8_t, size_t(Routing::Target::Last)> routedSet;
-static_assert(sizeof(uint8_t) * 8 >= CONFIG_TRACK_COUNT, "track bits do not fit");
-
-bool Routing::isRouted(Target target, int trackIndex) {
+bool Routing::isRouted(Target target, int trackIndex) const {
     size_t targetIndex = size_t(target);
     if (isPerTrackTarget(target)) {
         if (trackIndex >= 0 && trackIndex < CONFIG_TRACK_COUNT) {
-            return (routedSet[targetIndex] & (1 << trackIndex)) != 0;
+            return (_routedSet[targetIndex] & (1 << trackIndex)) != 0;
         }
     } else {
-        return routedSet[targetIndex] != 0;
+        return _routedSet[targetIndex] != 0;
     }
     return false;
 }
@@ -244,21 +232,56 @@ void Routing::setRouted(Target target, uint8_t tracks, bool routed) {
     size_t targetIndex = size_t(target);
     if (isPerTrackTarget(target)) {
         if (routed) {
-            routedSet[targetIndex] |= tracks;
+            _routedSet[targetIndex] |= tracks;
         } else {
-            routedSet[targetIndex] &= ~tracks;
+            _routedSet[targetIndex] &= ~tracks;
         }
     } else {
-        routedSet[targetIndex] = routed ? 1 : 0;
+        _routedSet[targetIndex] = routed ? 1 : 0;
     }
 }
 
-void Routing::printRouted(StringBuilder &str, Target target, int trackIndex) {
+void Routing::printRouted(StringBuilder &str, Target target, int trackIndex) const {
     if (isRouted(target, trackIndex)) {
         str("\x1a");
     }
 }
 
+int Routing::routedSequenceValue(Target target, int trackIndex) const {
+    return _routedSequenceValues[size_t(target) - size_t(Target::SequenceFirst)][trackIndex];
+}
+
+void Routing::clearRouted() {
+    _routedSet.fill(0);
+    for (auto &values : _routedSequenceValues) {
+        values.fill(0);
+    }
+}
+
+void Routing::writeRoutedSequenceValue(Target target, uint8_t tracks, int value) {
+    switch (target) {
+    case Target::Divisor:
+        value = ModelUtils::clampDivisor(value);
+        break;
+    case Target::RunMode:
+        value = int(ModelUtils::clampedEnum(Types::RunMode(value)));
+        break;
+    case Target::FirstStep:
+    case Target::LastStep:
+        value = clamp(value, 0, CONFIG_STEP_COUNT - 1);
+        break;
+    default:
+        break;
+    }
+
+    auto &values = _routedSequenceValues[size_t(target) - size_t(Target::SequenceFirst)];
+    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+        if (tracks & (1<<trackIndex)) {
+            values[trackIndex] = value;
+        }
+    }
+}
+
 struct TargetInfo {
     int16_t min;
     int16_t max;
@@ -526,12 +526,18 @@ public:
     bool isDirty() const { return _dirty; }
     void clearDirty() { _dirty = false; }
 
-    // global state for keeping active set of routed targets
-    static bool isRouted(Target target, int trackIndex = -1);
-    static void setRouted(Target target, uint8_t tracks, bool routed);
-    static void printRouted(StringBuilder &str, Target target, int trackIndex = -1);
+    // active set of routed targets
+    bool isRouted(Target target, int trackIndex = -1) const;
+    void setRouted(Target target, uint8_t tracks, bool routed);
+    void printRouted(StringBuilder &str, Target target, int trackIndex = -1) const;
+
+    // routed values of sequence targets, stored once per track and shared by all patterns
+    int routedSequenceValue(Target target, int trackIndex) const;
 
 private:
+    void writeRoutedSequenceValue(Target target, uint8_t tracks, int value);
+    void clearRouted();
+
     static float normalizeTargetValue(Target target, float value);
     static float denormalizeTargetValue(Target target, float normalized);
     static std::pair<float, float> normalizedDefaultRange(Target target);
@@ -541,6 +547,10 @@ private:
     Project &_project;
     RouteArray _routes;
     bool _dirty;
+
+    static_assert(sizeof(uint8_t) * 8 >= CONFIG_TRACK_COUNT, "track bits do not fit");
+    std::array<uint8_t, size_t(Target::Last)> _routedSet = {};
+    std::array<std::array<uint16_t, CONFIG_TRACK_COUNT>, size_t(Target::SequenceLast) - size_t(Target::SequenceFirst) + 1> _routedSequenceValues = {};
 };
 
 // Routable parameters store both a base and routed value.
@@ -1,10 +1,35 @@
 #include "Scale.h"
 #include "UserScale.h"
 
+#include "core/Debug.h"
+
+#include <array>
+
+// lookup tables of builtin scales are generated at compile time to keep them in flash
+
+template<int... Is>
+struct Indices {};
+
+template<int N, int... Is>
+struct MakeIndices : MakeIndices<N - 1, N - 1, Is...> {};
+
+template<int... Is>
+struct MakeIndices<0, Is...> {
+    typedef Indices<Is...> Type;
+};
+
+typedef std::array<float, Scale::LookupSize> NoteVoltsTable;
+
+template<int... Is>
+static constexpr NoteVoltsTable makeNoteVoltsTable(const uint16_t *notes, int noteCount, Indices<Is...>) {
+    return {{ NoteScale::staticNoteToVolts(notes, noteCount, Scale::LookupMin + Is)... }};
+}
+
 #define ARRAY_SIZE(_array_) (sizeof(_array_) / sizeof(_array_[0]))
 #define NOTE_SCALE(_name_, _title_, _chromatic_, ...) \
-static const uint16_t _name_##_notes[] = { __VA_ARGS__ }; \
-static const NoteScale _name_(_title_, _chromatic_, ARRAY_SIZE(_name_##_notes), _name_##_notes);
+static constexpr uint16_t _name_##_notes[] = { __VA_ARGS__ }; \
+static constexpr NoteVoltsTable _name_##_table = makeNoteVoltsTable(_name_##_notes, ARRAY_SIZE(_name_##_notes), MakeIndices<Scale::LookupSize>::Type()); \
+static const NoteScale _name_(_title_, _chromatic_, ARRAY_SIZE(_name_##_notes), _name_##_notes, _name_##_table.data());
 
 NOTE_SCALE(semitoneScale, "Semitones", true, 0, 128, 256, 384, 512, 640, 768, 896, 1024, 1152, 1280, 1408)
 
@@ -66,17 +91,13 @@ static const Scale *scales[] = {
     &voltageScale
 };
 
-static const int BuiltinCount = sizeof(scales) / sizeof(Scale *);
-static const int UserCount = UserScale::userScales.size();
+const int Scale::BuiltinCount = sizeof(scales) / sizeof(Scale *);
 
-int Scale::Count = BuiltinCount + UserCount;
+int Scale::Count = BuiltinCount + CONFIG_USER_SCALE_COUNT;
 
 const Scale &Scale::get(int index) {
-    if (index < BuiltinCount) {
-        return *scales[index];
-    } else {
-        return UserScale::userScales[index - BuiltinCount];
-    }
+    ASSERT(index < BuiltinCount, "not a builtin scale");
+    return *scales[index];
 }
 
 const char *Scale::name(int index) {
@@ -18,33 +18,63 @@ public:
         Long,
     };
 
-    Scale(const char *name) :
-        _displayName(name)
+    // note range covered by lookup tables (matches NoteSequence::Note)
+    static constexpr int LookupMin = -64;
+    static constexpr int LookupMax = 63;
+    static constexpr int LookupSize = LookupMax - LookupMin + 1;
+
+    Scale(const char *name, const float *noteVoltsTable = nullptr) :
+        _displayName(name),
+        _noteVoltsTable(noteVoltsTable)
     {}
 
     virtual bool isChromatic() const = 0;
 
     virtual void noteName(StringBuilder &str, int note, Format format = Long) const = 0;
-    virtual float noteToVolts(int note) const = 0;
     virtual int noteFromVolts(float volts) const = 0;
 
+    float noteToVolts(int note) const {
+        if (_noteVoltsTable && note >= LookupMin && note <= LookupMax) {
+            return _noteVoltsTable[note - LookupMin];
+        }
+        return calcNoteToVolts(note);
+    }
+
     virtual int notesPerOctave() const = 0;
 
+    // incremented whenever the note to voltage mapping changes
+    uint32_t revision() const { return _revision; }
+
+    // scale indices cover the builtin scales followed by the user scales,
+    // user scales are owned by the project and resolved through Project::scale()
+    static const int BuiltinCount;
     static int Count;
     static const Scale &get(int index);
     static const char *name(int index);
 
+protected:
+    // computes the note voltage, used for notes outside the lookup table
+    virtual float calcNoteToVolts(int note) const = 0;
+
+    void setNoteVoltsTable(const float *noteVoltsTable) { _noteVoltsTable = noteVoltsTable; }
+
+    const float *noteVoltsTable() const { return _noteVoltsTable; }
+
+    void changed() { ++_revision; }
+
 private:
     const char *displayName() const { return _displayName; }
 
     const char *_displayName;
+    const float *_noteVoltsTable;
+    uint32_t _revision = 0;
 };
 
 
 class NoteScale : public Scale {
 public:
-    NoteScale(const char *name, bool chromatic, uint16_t noteCount, const uint16_t *notes) :
-        Scale(name),
+    NoteScale(const char *name, bool chromatic, uint16_t noteCount, const uint16_t *notes, const float *noteVoltsTable) :
+        Scale(name, noteVoltsTable),
         _chromatic(chromatic),
         _noteCount(noteCount),
         _notes(notes)
@@ -76,23 +106,23 @@ public:
         }
     }
 
-    float noteToVolts(int note) const override {
-        int octave = roundDownDivide(note, _noteCount);
-        int index = note - octave * _noteCount;
-        return octave + _notes[index] * (1.f / 1536.f);
-    }
-
     int noteFromVolts(float volts) const override {
         volts += 0.01f;
         int octave = std::floor(volts);
         float fractional = volts - octave;
 
         int index = -1;
-        for (int i = 0; i < _noteCount; ++i) {
-            if (fractional < _notes[i] * (1.f / 1536.f)) {
-                break;
+        if (noteVoltsTable() && _noteCount <= LookupMax + 1) {
+            // binary search the first octave of the lookup table
+            const float *octaveVolts = noteVoltsTable() - LookupMin;
+            index = int(std::upper_bound(octaveVolts, octaveVolts + _noteCount, fractional) - octaveVolts) - 1;
+        } else {
+            for (int i = 0; i < _noteCount; ++i) {
+                if (fractional < _notes[i] * (1.f / 1536.f)) {
+                    break;
+                }
+                index = i;
             }
-            index = i;
         }
 
         if (index == -1) {
@@ -107,7 +137,23 @@ public:
         return _noteCount;
     }
 
+    // compile time version of calcNoteToVolts() used to generate lookup tables
+    static constexpr float staticNoteToVolts(const uint16_t *notes, int noteCount, int note) {
+        return noteOctave(note, noteCount) + notes[note - noteOctave(note, noteCount) * noteCount] * (1.f / 1536.f);
+    }
+
+protected:
+    float calcNoteToVolts(int note) const override {
+        int octave = roundDownDivide(note, _noteCount);
+        int index = note - octave * _noteCount;
+        return octave + _notes[index] * (1.f / 1536.f);
+    }
+
 private:
+    static constexpr int noteOctave(int note, int noteCount) {
+        return note >= 0 ? note / noteCount : (note - noteCount + 1) / noteCount;
+    }
+
     bool _chromatic;
     uint16_t _noteCount;
     const uint16_t *_notes;
@@ -139,10 +185,6 @@ public:
         }
     }
 
-    float noteToVolts(int note) const override {
-        return note * _interval;
-    }
-
     int noteFromVolts(float volts) const override {
         return int(std::floor(volts / _interval));
     }
@@ -151,6 +193,12 @@ public:
         return std::max(1, int(std::round(1.f / _interval)));
     }
 
+protected:
+    // trivial conversion, no lookup table needed
+    float calcNoteToVolts(int note) const override {
+        return note * _interval;
+    }
+
 private:
     float _interval;
 };
@@ -4,6 +4,7 @@
 void Track::clear() {
     _trackMode = TrackMode::Default;
     _linkTrack = -1;
+    _dirty = true;
 
     initContainer();
 }
@@ -90,6 +91,7 @@ void Track::read(ReadContext &context) {
     auto &reader = context.reader;
     reader.readEnum(_trackMode, trackModeSerialize);
     reader.read(_linkTrack);
+    _dirty = true;
 
     initContainer();
 
@@ -128,6 +130,7 @@ void Track::initContainer() {
     }
 
     setContainerTrackIndex(_trackIndex);
+    setContainerRouting(_routing);
 }
 
 void Track::setTrackIndex(int trackIndex) {
@@ -135,6 +138,11 @@ void Track::setTrackIndex(int trackIndex) {
     setContainerTrackIndex(_trackIndex);
 }
 
+void Track::setRouting(const Routing *routing) {
+    _routing = routing;
+    setContainerRouting(_routing);
+}
+
 void Track::setContainerTrackIndex(int trackIndex) {
     switch (_trackMode) {
     case TrackMode::Note:
@@ -150,3 +158,19 @@ void Track::setContainerTrackIndex(int trackIndex) {
         break;
     }
 }
+
+void Track::setContainerRouting(const Routing *routing) {
+    switch (_trackMode) {
+    case TrackMode::Note:
+        _track.note->setRouting(routing);
+        break;
+    case TrackMode::Curve:
+        _track.curve->setRouting(routing);
+        break;
+    case TrackMode::MidiCv:
+        _track.midiCv->setRouting(routing);
+        break;
+    case TrackMode::Last:
+        break;
+    }
+}
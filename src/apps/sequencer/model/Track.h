@@ -79,7 +79,11 @@ public:
 
     int linkTrack() const { return _linkTrack; }
     void setLinkTrack(int linkTrack) {
-        _linkTrack = clamp(linkTrack, -1, _trackIndex - 1);
+        linkTrack = clamp(linkTrack, -1, _trackIndex - 1);
+        if (linkTrack != _linkTrack) {
+            _linkTrack = linkTrack;
+            _dirty = true;
+        }
     }
 
     void editLinkTrack(int value, bool shift) {
@@ -127,17 +131,25 @@ public:
     void write(WriteContext &context) const;
     void read(ReadContext &context);
 
+    // set when the track mode or link track changed
+    bool isDirty() const { return _dirty; }
+    void clearDirty() { _dirty = false; }
+
     Track &operator=(const Track &other) {
         ASSERT(_trackMode == other._trackMode, "invalid track mode");
         _linkTrack = other._linkTrack;
+        _dirty = true;
         _container = other._container;
         setContainerTrackIndex(_trackIndex);
+        setContainerRouting(_routing);
         return *this;
     }
 
 private:
     void setTrackIndex(int trackIndex);
     void setContainerTrackIndex(int trackIndex);
+    void setRouting(const Routing *routing);
+    void setContainerRouting(const Routing *routing);
 
     // Note: always call through Project::setTrackMode
     void setTrackMode(TrackMode trackMode) {
@@ -145,14 +157,17 @@ private:
         if (trackMode != _trackMode) {
             _trackMode = trackMode;
             initContainer();
+            _dirty = true;
         }
     }
 
     void initContainer();
 
+    const Routing *_routing = nullptr;
     uint8_t _trackIndex = -1;
     TrackMode _trackMode;
     int8_t _linkTrack;
+    bool _dirty = true;
 
     Container<NoteTrack, CurveTrack, MidiCvTrack> _container;
     union {
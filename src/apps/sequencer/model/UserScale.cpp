@@ -1,26 +1,42 @@
 #include "UserScale.h"
 #include "ProjectVersion.h"
 
-UserScale::Array UserScale::userScales;
-
 UserScale::UserScale() :
     Scale("")
 {
+    setNoteVoltsTable(_noteVoltsTable.data());
     clear();
 }
 
+UserScale::UserScale(const UserScale &other) :
+    UserScale()
+{
+    *this = other;
+}
+
+UserScale &UserScale::operator=(const UserScale &other) {
+    StringUtils::copy(_name, other._name, sizeof(_name));
+    _mode = other._mode;
+    _size = other._size;
+    _items = other._items;
+    updateLookup();
+    return *this;
+}
+
 void UserScale::clear() {
     StringUtils::copy(_name, "INIT", sizeof(_name));
-    setMode(Mode::Chromatic);
+    _mode = Mode::Chromatic;
     clearItems();
 }
 
 void UserScale::clearItems() {
-    setSize(1);
+    // reset size and items first and rebuild the lookup table once
+    _size = _mode == Mode::Chromatic ? 1 : 2;
     _items.fill(0);
     if (_mode == Mode::Voltage) {
         _items[1] = 1000;
     }
+    updateLookup();
 }
 
 void UserScale::write(WriteContext &context) const {
@@ -55,6 +71,8 @@ bool UserScale::read(ReadContext &context) {
         clear();
     }
 
+    updateLookup();
+
     return success;
 }
 
@@ -107,3 +125,11 @@ fs::Error UserScale::read(const char *path) {
 
     return error;
 }
+
+void UserScale::updateLookup() {
+    for (int i = 0; i < LookupSize; ++i) {
+        _noteVoltsTable[i] = calcNoteToVolts(LookupMin + i);
+    }
+    _itemsSorted = std::is_sorted(_items.begin(), _items.begin() + _size);
+    changed();
+}
@@ -11,6 +11,7 @@
 #include "core/math/Math.h"
 #include "core/utils/StringUtils.h"
 
+#include <algorithm>
 #include <array>
 
 #include <cstdint>
@@ -76,6 +77,7 @@ public:
     int size() const { return _size; }
     void setSize(int size) {
         _size = clamp(size, _mode == Mode::Chromatic ? 1 : 2, CONFIG_USER_SCALE_SIZE);
+        updateLookup();
     }
 
     void editSize(int value, bool shift) {
@@ -89,7 +91,6 @@ public:
     // items
 
     const ItemArray &items() const { return _items; }
-          ItemArray &items()       { return _items; }
 
     int item(int index) const { return _items[index]; }
     void setItem(int index, int value) {
@@ -103,6 +104,7 @@ public:
         case Mode::Last:
             break;
         }
+        updateLookup();
     }
 
     void editItem(int index, int value, int shift) {
@@ -136,6 +138,9 @@ public:
     //----------------------------------------
 
     UserScale();
+    UserScale(const UserScale &other);
+
+    UserScale &operator=(const UserScale &other);
 
     void clear();
     void clearItems();
@@ -167,21 +172,6 @@ public:
         }
     }
 
-    float noteToVolts(int note) const override {
-        int notesPerOctave_ = notesPerOctave();
-        int octave = roundDownDivide(note, notesPerOctave_);
-        int index = note - octave * notesPerOctave_;
-        switch (_mode) {
-        case Mode::Chromatic:
-            return octave + _items[index] * (1.f / 12.f);
-        case Mode::Voltage:
-            return octave * octaveRangeVolts() + _items[index] * (1.f / 1000.f);
-        case Mode::Last:
-            break;
-        }
-        return 0.f;
-    }
-
     int noteFromVolts(float volts) const override {
         switch (_mode) {
         case Mode::Chromatic:
@@ -198,9 +188,25 @@ public:
         return _mode == Mode::Chromatic ? _size : _size - 1;
     }
 
-    static Array userScales;
+protected:
+    float calcNoteToVolts(int note) const override {
+        int notesPerOctave_ = notesPerOctave();
+        int octave = roundDownDivide(note, notesPerOctave_);
+        int index = note - octave * notesPerOctave_;
+        switch (_mode) {
+        case Mode::Chromatic:
+            return octave + _items[index] * (1.f / 12.f);
+        case Mode::Voltage:
+            return octave * octaveRangeVolts() + _items[index] * (1.f / 1000.f);
+        case Mode::Last:
+            break;
+        }
+        return 0.f;
+    }
 
 private:
+    void updateLookup();
+
     void noteNameChromaticMode(StringBuilder &str, int note, Format format) const {
         bool printNote = format == Short1 || format == Long;
         bool printOctave = format == Short2 || format == Long;
@@ -234,16 +240,11 @@ private:
 
     int noteFromVoltsChromaticMode(float volts) const {
         int semiNotes = std::floor(volts * 12.f + 0.01f);
+
         int octave = roundDownDivide(semiNotes, 12);
         semiNotes -= octave * 12;
 
-        int index = -1;
-        for (int i = 0; i < _size; ++i) {
-            if (semiNotes < _items[i]) {
-                break;
-            }
-            index = i;
-        }
+        int index = findItem(semiNotes);
 
         if (index == -1) {
             index = _size -1;
@@ -259,13 +260,7 @@ private:
         volts -= octave * octaveRange;
         int itemValue = int(std::floor(volts * 1000.f));
 
-        int index = -1;
-        for (int i = 0; i < _size; ++i) {
-            if (itemValue < _items[i]) {
-                break;
-            }
-            index = i;
-        }
+        int index = findItem(itemValue);
 
         if (index == -1) {
             index = _size -1;
@@ -275,6 +270,21 @@ private:
         return octave * (_size - 1) + index;
     }
 
+    // returns the index of the last item <= value before the first item > value, -1 if there is none
+    int findItem(int value) const {
+        if (_itemsSorted) {
+            return int(std::upper_bound(_items.begin(), _items.begin() + _size, value) - _items.begin()) - 1;
+        }
+        int index = -1;
+        for (int i = 0; i < _size; ++i) {
+            if (value < _items[i]) {
+                break;
+            }
+            index = i;
+        }
+        return index;
+    }
+
     float octaveRangeVolts() const {
         return (_items[_size - 1] - _items[0]) * (1.f / 1000.f);
     }
@@ -283,4 +293,7 @@ private:
     Mode _mode;
     uint8_t _size;
     ItemArray _items;
+
+    std::array<float, LookupSize> _noteVoltsTable;
+    bool _itemsSorted;
 };
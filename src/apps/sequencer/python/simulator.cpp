@@ -13,7 +13,8 @@ void register_simulator(py::module &m) {
 
     py::class_<Simulator> simulator(m, "Simulator", py::dynamic_attr());
     simulator
-        .def("wait", &Simulator::wait)
+        .def("wait", &Simulator::wait, py::call_guard<py::gil_scoped_release>())
+        .def("run", &Simulator::run, py::call_guard<py::gil_scoped_release>())
         .def("setButton", &Simulator::setButton)
         .def("setEncoder", &Simulator::setEncoder)
         .def("rotateEncoder", &Simulator::rotateEncoder)
@@ -24,6 +25,13 @@ void register_simulator(py::module &m) {
         .def_property_readonly("targetState", &Simulator::targetState, py::return_value_policy::reference)
     ;
 
+    py::class_<Simulator::RunStats> runStats(simulator, "RunStats");
+    runStats
+        .def_readonly("simulatedMs", &Simulator::RunStats::simulatedMs)
+        .def_readonly("wallMs", &Simulator::RunStats::wallMs)
+        .def_property_readonly("speed", &Simulator::RunStats::speed)
+    ;
+
     // ------------------------------------------------------------------------
     // TargetTrace
     // ------------------------------------------------------------------------
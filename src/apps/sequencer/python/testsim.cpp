@@ -13,7 +13,7 @@ struct Environment {
     Environment() {
         simulator.reset(new sim::Simulator({
             .create = [this] () {
-                sequencer.reset(new SequencerApp());
+                sequencer.reset(new SequencerApp(*simulator));
             },
             .destroy = [this] () {
                 sequencer.reset();
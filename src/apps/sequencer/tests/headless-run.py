@@ -0,0 +1,17 @@
+import sys
+import testframework as tf
+
+# usage: headless-run.py [duration in ms]
+duration = int(sys.argv[1]) if len(sys.argv) > 1 else 60000
+
+env = tf.Environment()
+c = tf.Controller(env.simulator)
+
+c.wait(1000)
+
+# start playback
+c.press("play")
+
+stats = c.run(duration)
+
+print("simulated %d ms in %.1f ms (%.1f simulated ms per wall ms)" % (stats.simulatedMs, stats.wallMs, stats.speed))
@@ -67,6 +67,9 @@ class Controller:
         self._simulator.wait(ms)
         return self
 
+    def run(self, ms):
+        return self._simulator.run(ms)
+
     def down(self, button):
         self._simulator.setButton(buttonMap[button], True)
         return self
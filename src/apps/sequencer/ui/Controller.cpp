@@ -14,3 +14,7 @@ Controller::~Controller() {
 bool Controller::sendMidi(const MidiMessage &message) {
     return _manager.sendMidi(message);
 }
+
+bool Controller::sendSysEx(const uint8_t *data, size_t length) {
+    return _manager.sendSysEx(data, length);
+}
@@ -29,6 +29,7 @@ public:
 
 protected:
     bool sendMidi(const MidiMessage &message);
+    bool sendSysEx(const uint8_t *data, size_t length);
 
     ControllerManager &_manager;
     Model &_model;
@@ -62,3 +62,7 @@ bool ControllerManager::recvMidi(MidiPort port, const MidiMessage &message) {
 bool ControllerManager::sendMidi(const MidiMessage &message) {
     return _engine.sendMidi(_port, message);
 }
+
+bool ControllerManager::sendSysEx(const uint8_t *data, size_t length) {
+    return _engine.sendSysEx(_port, data, length);
+}
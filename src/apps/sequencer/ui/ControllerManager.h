@@ -28,6 +28,7 @@ public:
 
 private:
     bool sendMidi(const MidiMessage &message);
+    bool sendSysEx(const uint8_t *data, size_t length);
 
     Model &_model;
     Engine &_engine;
@@ -9,19 +9,24 @@
 
 #include "model/Model.h"
 
-Ui::Ui(Model &model, Engine &engine, Lcd &lcd, ButtonLedMatrix &blm, Encoder &encoder) :
+PROFILER_INTERVAL(ui_draw, "Ui::draw")
+PROFILER_INTERVAL(lcd_draw, "Lcd::draw")
+
+Ui::Ui(Model &model, Engine &engine, FileManager &fileManager, Lcd &lcd, ButtonLedMatrix &blm, Encoder &encoder) :
     _model(model),
     _engine(engine),
+    _fileManager(fileManager),
     _lcd(lcd),
     _blm(blm),
     _encoder(encoder),
     _frameBuffer(CONFIG_LCD_WIDTH, CONFIG_LCD_HEIGHT, _frameBufferData),
     _canvas(_frameBuffer),
     _pageManager(_pages),
-    _pageContext({ _messageManager, _pageKeyState, _globalKeyState, _model, _engine }),
+    _pageContext({ _messageManager, _pageKeyState, _globalKeyState, _model, _engine, _fileManager }),
     _pages(_pageManager, _pageContext),
     _controllerManager(model, engine)
 {
+    _canvas.setTextCache(&_textCache);
 }
 
 void Ui::init() {
@@ -67,6 +72,9 @@ void Ui::init() {
 }
 
 void Ui::update() {
+    // file task results are delivered in the ui task
+    _fileManager.processTaskResults();
+
     handleKeys();
     handleEncoder();
     handleMidi();
@@ -84,10 +92,15 @@ void Ui::update() {
     uint32_t currentTicks = os::ticks();
     uint32_t intervalTicks = os::time::ms(1000 / _pageManager.fps());
     if (currentTicks - _lastFrameBufferUpdateTicks >= intervalTicks) {
+        PROFILER_INTERVAL_BEGIN(ui_draw);
+        _textCache.nextFrame();
         _pageManager.draw(_canvas);
         _messageManager.update();
         _messageManager.draw(_canvas);
+        PROFILER_INTERVAL_END(ui_draw);
+        PROFILER_INTERVAL_BEGIN(lcd_draw);
         _lcd.draw(_frameBuffer.data());
+        PROFILER_INTERVAL_END(lcd_draw);
         _lastFrameBufferUpdateTicks += intervalTicks;
     }
 
@@ -17,18 +17,20 @@
 
 #include "core/gfx/FrameBuffer.h"
 #include "core/gfx/Canvas.h"
+#include "core/gfx/TextCache.h"
 #include "core/utils/RingBuffer.h"
 #include "core/midi/MidiMessage.h"
 
 #include "engine/Engine.h"
 
 #include "model/Model.h"
+#include "model/FileManager.h"
 
 class Key;
 
 class Ui {
 public:
-    Ui(Model &model, Engine &engine, Lcd &lcd, ButtonLedMatrix &blm, Encoder &encoder);
+    Ui(Model &model, Engine &engine, FileManager &fileManager, Lcd &lcd, ButtonLedMatrix &blm, Encoder &encoder);
 
     void init();
     void update();
@@ -42,15 +44,17 @@ private:
 
     Model &_model;
     Engine &_engine;
+    FileManager &_fileManager;
 
     Lcd &_lcd;
     ButtonLedMatrix &_blm;
     Encoder &_encoder;
     RingBuffer<std::pair<MidiPort, MidiMessage>, 16> _midiMessages;
 
-    uint8_t _frameBufferData[CONFIG_LCD_WIDTH * CONFIG_LCD_HEIGHT];
-    FrameBuffer8bit _frameBuffer;
+    uint8_t _frameBufferData[CONFIG_LCD_WIDTH * CONFIG_LCD_HEIGHT / 2];
+    FrameBuffer4bit _frameBuffer;
     Canvas _canvas;
+    TextCache _textCache;
     uint32_t _lastFrameBufferUpdateTicks;
 
     KeyState _pageKeyState;
@@ -109,6 +109,10 @@ LaunchpadController::LaunchpadController(ControllerManager &manager, Model &mode
         return sendMidi(message);
     });
 
+    _device->setSendSysExHandler([this] (const uint8_t *data, size_t length) {
+        return sendSysEx(data, length);
+    });
+
     _device->setButtonHandler([this] (int row, int col, bool state) {
         // DBG("button %d/%d - %d", row, col, state);
         if (state) {
@@ -756,7 +760,7 @@ void LaunchpadController::drawNoteSequenceNotes(const NoteSequence &sequence, No
     int ofs = _sequence.navigation.row * 8;
 
     // draw octave lines
-    int octave = sequence.selectedScale(_project.scale()).notesPerOctave();
+    int octave = _project.selectedScale(sequence).notesPerOctave();
     for (int row = 0; row < 8; ++row) {
         if (modulo(row + ofs, octave) == 0) {
             for (int col = 0; col < 8; ++col) {
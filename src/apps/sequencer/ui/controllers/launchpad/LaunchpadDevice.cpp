@@ -22,6 +22,8 @@
 //  |112|...|   |   |   |   |   |119|  |120|
 //  +---+---+---+---+---+---+---+---+  +---+
 
+constexpr uint8_t LaunchpadDevice::SysExHeader[];
+
 LaunchpadDevice::LaunchpadDevice()
 {
     std::fill(_deviceLedState.begin(), _deviceLedState.end(), 0xff);
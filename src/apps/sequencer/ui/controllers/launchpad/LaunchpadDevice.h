@@ -18,6 +18,7 @@ public:
     static constexpr int FunctionRow = 9;
 
     typedef std::function<bool(const MidiMessage &)> SendMidiHandler;
+    typedef std::function<bool(const uint8_t *, size_t)> SendSysExHandler;
     typedef std::function<void(int, int, bool)> ButtonHandler;
 
     struct Color {
@@ -41,6 +42,10 @@ public:
         _sendMidiHandler = sendMidiHandler;
     }
 
+    void setSendSysExHandler(SendSysExHandler sendSysExHandler) {
+        _sendSysExHandler = sendSysExHandler;
+    }
+
     virtual void recvMidi(const MidiMessage &message);
 
     // button handling
@@ -78,6 +83,50 @@ protected:
         return false;
     }
 
+    bool sendSysEx(const uint8_t *data, size_t length) {
+        if (_sendSysExHandler) {
+            return _sendSysExHandler(data, length);
+        }
+        return false;
+    }
+
+    // Sends all changed leds in a single "set leds" sysex message (Launchpad Mk2 and Pro).
+    // Returns false if this would not use fewer USB MIDI packets than sending
+    // individual messages, or if the message could not be sent.
+    template<typename LedNumber>
+    bool syncLedsSysEx(uint8_t deviceId, LedNumber ledNumber) {
+        int changed = 0;
+        for (int index = 0; index < ButtonCount; ++index) {
+            changed += _deviceLedState[index] != _ledState[index] ? 1 : 0;
+        }
+        // usb midi packets carry 3 bytes of sysex, individual messages take one packet each
+        int length = sizeof(SysExHeader) + 2 + changed * 2 + 1;
+        if ((length + 2) / 3 >= changed) {
+            return false;
+        }
+
+        uint8_t data[sizeof(SysExHeader) + 2 + ButtonCount * 2 + 1];
+        uint8_t *p = data;
+        for (auto byte : SysExHeader) {
+            *p++ = byte;
+        }
+        *p++ = deviceId;
+        *p++ = 0x0a; // set leds
+        for (int index = 0; index < ButtonCount; ++index) {
+            if (_deviceLedState[index] != _ledState[index]) {
+                *p++ = ledNumber(index);
+                *p++ = _ledState[index];
+            }
+        }
+        *p++ = 0xf7;
+
+        if (!sendSysEx(data, p - data)) {
+            return false;
+        }
+        _deviceLedState = _ledState;
+        return true;
+    }
+
     void setButtonState(int row, int col, bool state) {
         _buttonState[row * Cols + col] = state;
         if (_buttonHandler) {
@@ -85,7 +134,11 @@ protected:
         }
     }
 
+    // sysex start and novation manufacturer id
+    static constexpr uint8_t SysExHeader[] = { 0xf0, 0x00, 0x20, 0x29, 0x02 };
+
     SendMidiHandler _sendMidiHandler;
+    SendSysExHandler _sendSysExHandler;
     ButtonHandler _buttonHandler;
     std::bitset<ButtonCount> _buttonState;
     std::array<uint8_t, ButtonCount> _ledState;
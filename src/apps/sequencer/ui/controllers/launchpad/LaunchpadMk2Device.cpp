@@ -46,12 +46,16 @@ void LaunchpadMk2Device::recvMidi(const MidiMessage &message) {
 }
 
 void LaunchpadMk2Device::syncLeds() {
+    if (syncLedsSysEx(0x18, [] (int index) { return ledNumber(index / Cols, index % Cols); })) {
+        return;
+    }
+
     // grid
     for (int row = 0; row < Rows; ++row) {
         for (int col = 0; col < Cols; ++col) {
             int index = row * Cols + col;
             if (_deviceLedState[index] != _ledState[index]) {
-                if (sendMidi(MidiMessage::makeNoteOn(0, 11 + 10 * (7 - row) + col, _ledState[index]))) {
+                if (sendMidi(MidiMessage::makeNoteOn(0, ledNumber(row, col), _ledState[index]))) {
                     _deviceLedState[index] = _ledState[index];
                 }
             }
@@ -62,7 +66,7 @@ void LaunchpadMk2Device::syncLeds() {
     for (int col = 0; col < Cols; ++col) {
         int index = SceneRow * Cols + col;
         if (_deviceLedState[index] != _ledState[index]) {
-            if (sendMidi(MidiMessage::makeNoteOn(0, 11 + 10 * (7 - col) + 8, _ledState[index]))) {
+            if (sendMidi(MidiMessage::makeNoteOn(0, ledNumber(SceneRow, col), _ledState[index]))) {
                 _deviceLedState[index] = _ledState[index];
             }
         }
@@ -72,7 +76,7 @@ void LaunchpadMk2Device::syncLeds() {
     for (int col = 0; col < Cols; ++col) {
         int index = FunctionRow * Cols + col;
         if (_deviceLedState[index] != _ledState[index]) {
-            if (sendMidi(MidiMessage::makeControlChange(0, 104 + col, _ledState[index]))) {
+            if (sendMidi(MidiMessage::makeControlChange(0, ledNumber(FunctionRow, col), _ledState[index]))) {
                 _deviceLedState[index] = _ledState[index];
             }
         }
@@ -22,6 +22,16 @@ public:
     void syncLeds() override;
 
 private:
+    // led number used in note, control change and sysex messages
+    static uint8_t ledNumber(int row, int col) {
+        if (row == SceneRow) {
+            return 11 + 10 * (7 - col) + 8;
+        } else if (row == FunctionRow) {
+            return 104 + col;
+        }
+        return 11 + 10 * (7 - row) + col;
+    }
+
     inline uint8_t mapColor(int red, int green) const {
         static const uint8_t map[] = {
         //  g0 g1 g2 g3
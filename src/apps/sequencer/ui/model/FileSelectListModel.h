@@ -8,6 +8,10 @@
 
 class FileSelectListModel : public ListModel {
 public:
+    FileSelectListModel(FileManager &fileManager) :
+        _fileManager(fileManager)
+    {}
+
     void setType(FileType type) {
         _type = type;
     }
@@ -32,9 +36,10 @@ public:
 private:
     void formatName(int row, StringBuilder &str) const {
         FileManager::SlotInfo info;
-        FileManager::slotInfo(_type, row, info);
+        _fileManager.slotInfo(_type, row, info);
         str("%d: %s", row + 1, info.used ? info.name : "(empty)");
     }
 
+    FileManager &_fileManager;
     FileType _type;
 };
@@ -20,3 +20,29 @@ void BasePage::showContextMenu(const ContextMenu &contextMenu) {
     _context.contextMenu = contextMenu;
     _manager.pages().contextMenu.show(_context.contextMenu, _context.contextMenu.actionCallback());
 }
+
+bool BasePage::fileTask(const char *busyText, FileManager::TaskExecuteCallback executeCallback, FileManager::TaskResultCallback resultCallback, bool lockEngine) {
+    if (lockEngine) {
+        _engine.lock();
+    }
+    _manager.pages().busy.show(busyText);
+
+    auto taskId = _context.fileManager.task(executeCallback, [this, resultCallback, lockEngine] (fs::Error result) {
+        resultCallback(result);
+        _manager.pages().busy.close();
+        if (lockEngine) {
+            _engine.unlock();
+        }
+    });
+
+    if (!taskId) {
+        _manager.pages().busy.close();
+        if (lockEngine) {
+            _engine.unlock();
+        }
+        showMessage("FILE MANAGER BUSY");
+        return false;
+    }
+
+    return true;
+}
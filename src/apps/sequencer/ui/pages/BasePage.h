@@ -7,6 +7,7 @@
 #include "ui/pages/ContextMenu.h"
 
 #include "model/Model.h"
+#include "model/FileManager.h"
 
 #include "engine/Engine.h"
 
@@ -18,6 +19,7 @@ struct PageContext {
     KeyState &globalKeyState;
     Model &model;
     Engine &engine;
+    FileManager &fileManager;
 
     ContextMenu contextMenu;
 };
@@ -30,6 +32,11 @@ protected:
     void showMessage(const char *text, uint32_t duration = 1000);
     void showContextMenu(const ContextMenu &contextMenu);
 
+    // shows the busy page and queues a file task, the busy page is closed after the result callback
+    // was called. the engine is locked while the task is pending if lockEngine is set.
+    // if the task cannot be queued, everything is rolled back and false is returned.
+    bool fileTask(const char *busyText, FileManager::TaskExecuteCallback executeCallback, FileManager::TaskResultCallback resultCallback, bool lockEngine = true);
+
     const KeyState &pageKeyState() const { return _context.pageKeyState; }
     const KeyState &globalKeyState() const { return _context.globalKeyState; }
 
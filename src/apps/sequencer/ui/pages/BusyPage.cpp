@@ -39,7 +39,13 @@ void BusyPage::draw(Canvas &canvas) {
 
     canvas.drawTextCentered(0, 32 - 16, Width, 8, _text);
 
-    drawProgressBar(canvas, 16, 32 - 4, Width - 32, 8, 16, (os::ticks() / os::time::ms(50)) % 16);
+    float progress = _context.fileManager.taskProgress();
+    if (progress >= 0.f) {
+        canvas.drawRect(16, 32 - 4, Width - 32, 8);
+        canvas.fillRect(16, 32 - 4, int((Width - 32) * std::min(progress, 1.f)), 8);
+    } else {
+        drawProgressBar(canvas, 16, 32 - 4, Width - 32, 8, 16, (os::ticks() / os::time::ms(50)) % 16);
+    }
 }
 
 void BusyPage::updateLeds(Leds &leds) {
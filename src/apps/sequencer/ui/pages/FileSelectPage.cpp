@@ -11,7 +11,8 @@ static const char *functionNames[] = { nullptr, nullptr, nullptr, "CANCEL", "OK"
 
 
 FileSelectPage::FileSelectPage(PageManager &manager, PageContext &context) :
-    ListPage(manager, context, _listModel)
+    ListPage(manager, context, _listModel),
+    _listModel(context.fileManager)
 {}
 
 void FileSelectPage::show(const char *title, FileType type, int selectedSlot, bool allowEmpty, ResultCallback callback) {
@@ -67,7 +68,7 @@ void FileSelectPage::closeWithResult(bool result) {
     // cancel if empty slot is selected but not allowed to be
     if (result && !_allowEmpty) {
         FileManager::SlotInfo info;
-        FileManager::slotInfo(_type, selectedRow(), info);
+        _context.fileManager.slotInfo(_type, selectedRow(), info);
         if (!info.used) {
             return;
         }
@@ -7,14 +7,19 @@
 
 #include "core/utils/StringBuilder.h"
 
+#include <algorithm>
+
+#include <cstdlib>
+
 enum class Function {
     CvIn    = 0,
     CvOut   = 1,
     Midi    = 2,
     Stats   = 3,
+    Timing  = 4,
 };
 
-static const char *functionNames[] = { "CV IN", "CV OUT", "MIDI", "STATS", nullptr };
+static const char *functionNames[] = { "CV IN", "CV OUT", "MIDI", "STATS", "TIMING" };
 
 static void formatMidiMessage(StringBuilder &eventStr, StringBuilder &dataStr, const MidiMessage &msg) {
     if (msg.isChannelMessage()) {
@@ -107,6 +112,9 @@ void MonitorPage::draw(Canvas &canvas) {
     case Mode::Stats:
         drawStats(canvas);
         break;
+    case Mode::Timing:
+        drawTiming(canvas);
+        break;
     }
 }
 
@@ -134,6 +142,13 @@ void MonitorPage::keyPress(KeyPressEvent &event) {
         case Function::Stats:
             _mode = Mode::Stats;
             break;
+        case Function::Timing:
+            // pressing again resets the statistics
+            if (_mode == Mode::Timing) {
+                _engine.resetTimingStats();
+            }
+            _mode = Mode::Timing;
+            break;
         }
     }
 }
@@ -202,9 +217,12 @@ void MonitorPage::drawMidi(Canvas &canvas) {
 void MonitorPage::drawStats(Canvas &canvas) {
     auto stats = _engine.stats();
 
+    // two columns of 5 rows
     auto drawValue = [&] (int index, const char *name, const char *value) {
-        canvas.drawText(10, 20 + index * 10, name);
-        canvas.drawText(100, 20 + index * 10, value);
+        int x = (index / 5) * 128;
+        int y = 20 + (index % 5) * 10;
+        canvas.drawText(x + 10, y, name);
+        canvas.drawText(x + 100, y, value);
     };
 
     {
@@ -225,4 +243,55 @@ void MonitorPage::drawStats(Canvas &canvas) {
         drawValue(2, "USBMIDI OVF:", str);
     }
 
+    {
+        FixedStringBuilder<16> str("%d", stats.eventQueueOverflow);
+        drawValue(3, "QUEUE OVF:", str);
+    }
+
+    {
+        FixedStringBuilder<16> str("%d", stats.setupSkipped);
+        drawValue(4, "SETUP SKIP:", str);
+    }
+
+    {
+        FixedStringBuilder<16> str("%d", stats.midiTxHighWatermark);
+        drawValue(5, "MIDI TX HWM:", str);
+    }
+
+    {
+        FixedStringBuilder<16> str("%d", stats.midiTxBytesSaved);
+        drawValue(6, "MIDI TX SAVE:", str);
+    }
+
+}
+
+void MonitorPage::drawTiming(Canvas &canvas) {
+    auto stats = _engine.timingStats();
+
+    auto drawHistogram = [&] (int index, const char *name, const TimingHistogram &histogram) {
+        int y = 20 + index * 10;
+        canvas.drawText(4, y, name);
+
+        if (histogram.count() == 0) {
+            canvas.drawText(80, y, "-");
+            return;
+        }
+
+        FixedStringBuilder<16> str("AVG %d", int(histogram.mean()));
+        canvas.drawText(80, y, str);
+        str.reset();
+        str("MAX %d", int(std::max(std::abs(histogram.min()), std::abs(histogram.max()))));
+        canvas.drawText(130, y, str);
+
+        // bucket counts relative to the sample count
+        for (int i = 0; i < TimingHistogram::BucketCount; ++i) {
+            int h = (histogram.bucket(i) * 7 + histogram.count() - 1) / histogram.count();
+            canvas.fillRect(190 + i * 8, y - h, 6, h);
+        }
+    };
+
+    drawHistogram(0, "CLK JITTER", stats.clockJitter);
+    drawHistogram(1, "SLAVE LATENCY", stats.slaveLatency);
+    drawHistogram(2, "CLK OUT", stats.clockOutputLatency);
+    drawHistogram(3, "GATE OUT", stats.gateOutputLatency);
 }
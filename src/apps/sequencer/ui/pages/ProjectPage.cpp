@@ -119,7 +119,7 @@ bool ProjectPage::contextActionEnabled(int index) const {
     case ContextAction::Load:
     case ContextAction::Save:
     case ContextAction::SaveAs:
-        return FileManager::volumeMounted();
+        return _context.fileManager.volumeMounted();
     case ContextAction::Route:
         return _listModel.routingTarget(selectedRow()) != Routing::Target::None;
     default:
@@ -162,7 +162,7 @@ void ProjectPage::saveProject() {
 void ProjectPage::saveAsProject() {
     _manager.pages().fileSelect.show("SAVE PROJECT", FileType::Project, 0, true, [this] (bool result, int slot) {
         if (result) {
-            if (FileManager::slotUsed(FileType::Project, slot)) {
+            if (_context.fileManager.slotUsed(FileType::Project, slot)) {
                 _manager.pages().confirmation.show("ARE YOU SURE?", [this, slot] (bool result) {
                     if (result) {
                         saveProjectToSlot(slot);
@@ -180,30 +180,21 @@ void ProjectPage::initRoute() {
 }
 
 void ProjectPage::saveProjectToSlot(int slot) {
-    _engine.lock();
-    _manager.pages().busy.show("SAVING PROJECT ...");
-
-    FileManager::task([this, slot] () {
-        return FileManager::saveProject(_project, slot);
+    fileTask("SAVING PROJECT ...", [this, slot] () {
+        return _context.fileManager.saveProject(_project, slot);
     }, [this] (fs::Error result) {
         if (result == fs::OK) {
             showMessage("PROJECT SAVED");
         } else {
             showMessage(FixedStringBuilder<32>("FAILED (%s)", fs::errorToString(result)));
         }
-        // TODO lock ui mutex
-        _manager.pages().busy.close();
-        _engine.unlock();
     });
 }
 
 void ProjectPage::loadProjectFromSlot(int slot) {
-    _engine.lock();
-    _manager.pages().busy.show("LOADING PROJECT ...");
-
-    FileManager::task([this, slot] () {
+    fileTask("LOADING PROJECT ...", [this, slot] () {
         // TODO this is running in file manager thread but model notification affect ui
-        return FileManager::loadProject(_project, slot);
+        return _context.fileManager.loadProject(_project, slot);
     }, [this] (fs::Error result) {
         if (result == fs::OK) {
             showMessage("PROJECT LOADED");
@@ -212,8 +203,5 @@ void ProjectPage::loadProjectFromSlot(int slot) {
         } else {
             showMessage(FixedStringBuilder<32>("FAILED (%s)", fs::errorToString(result)));
         }
-        // TODO lock ui mutex
-        _manager.pages().busy.close();
-        _engine.unlock();
     });
 }
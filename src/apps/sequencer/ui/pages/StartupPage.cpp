@@ -16,12 +16,17 @@ void StartupPage::draw(Canvas &canvas) {
     if (_state == State::Initial) {
         _state = State::Loading;
         _engine.lock();
-        FileManager::task([this] () {
-            return FileManager::loadLastProject(_model.project());
+        auto taskId = _context.fileManager.task([this] () {
+            return _context.fileManager.loadLastProject(_model.project());
         }, [this] (fs::Error result) {
             _engine.unlock();
             _state = State::Ready;
         });
+        if (!taskId) {
+            // try again on next frame
+            _engine.unlock();
+            _state = State::Initial;
+        }
     }
 
     if (relTime() > 1.f && _state == State::Ready) {
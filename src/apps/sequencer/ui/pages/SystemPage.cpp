@@ -284,7 +284,7 @@ bool SystemPage::contextActionEnabled(int index) const {
     switch (ContextAction(index)) {
     case ContextAction::Backup:
     case ContextAction::Restore:
-        return FileManager::volumeMounted();
+        return _context.fileManager.volumeMounted();
     default:
         return true;
     }
@@ -326,25 +326,16 @@ void SystemPage::restoreSettings() {
 }
 
 void SystemPage::saveSettingsToFlash() {
-    _engine.lock();
-    _manager.pages().busy.show("SAVING SETTINGS ...");
-
-    FileManager::task([this] () {
+    fileTask("SAVING SETTINGS ...", [this] () {
         _model.settings().writeToFlash();
         return fs::OK;
     }, [this] (fs::Error result) {
         showMessage("SETTINGS SAVED");
-        // TODO lock ui mutex
-        _manager.pages().busy.close();
-        _engine.unlock();
     });
 }
 
 void SystemPage::backupSettingsToFile() {
-    _engine.lock();
-    _manager.pages().busy.show("BACKING UP SETTINGS ...");
-
-    FileManager::task([this] () {
+    fileTask("BACKING UP SETTINGS ...", [this] () {
         return _model.settings().write(Settings::Filename);
     }, [this] (fs::Error result) {
         if (result == fs::OK) {
@@ -352,17 +343,11 @@ void SystemPage::backupSettingsToFile() {
         } else {
             showMessage(FixedStringBuilder<32>("FAILED (%s)", fs::errorToString(result)));
         }
-        // TODO lock ui mutex
-        _manager.pages().busy.close();
-        _engine.unlock();
     });
 }
 
 void SystemPage::restoreSettingsFromFile() {
-    _engine.lock();
-    _manager.pages().busy.show("RESTORING SETTINGS ...");
-
-    FileManager::task([this] () {
+    fileTask("RESTORING SETTINGS ...", [this] () {
         return _model.settings().read(Settings::Filename);
     }, [this] (fs::Error result) {
         if (result == fs::OK) {
@@ -374,33 +359,26 @@ void SystemPage::restoreSettingsFromFile() {
             showMessage(FixedStringBuilder<32>("FAILED (%s)", fs::errorToString(result)));
             _model.settings().readFromFlash();
         }
-        // TODO lock ui mutex
-        _manager.pages().busy.close();
-        _engine.unlock();
     });
 }
 
 void SystemPage::formatSdCard() {
-    if (!FileManager::volumeAvailable()) {
+    if (!_context.fileManager.volumeAvailable()) {
         showMessage("NO SD CARD DETECTED!");
         return;
     }
 
     _manager.pages().confirmation.show("DO YOU REALLY WANT TO FORMAT THE SD CARD?", [this] (bool result) {
         if (result) {
-            _manager.pages().busy.show("FORMATTING SD CARD ...");
-
-            FileManager::task([] () {
-                return FileManager::format();
+            fileTask("FORMATTING SD CARD ...", [this] () {
+                return _context.fileManager.format();
             }, [this] (fs::Error result) {
                 if (result == fs::OK) {
                     showMessage("SD CARD FORMATTED");
                 } else {
                     showMessage(FixedStringBuilder<32>("FAILED (%s)", fs::errorToString(result)));
                 }
-                // TODO lock ui mutex
-                _manager.pages().busy.close();
-            });
+            }, false);
         }
     });
 }
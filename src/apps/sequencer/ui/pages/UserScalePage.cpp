@@ -77,7 +77,7 @@ void UserScalePage::keyPress(KeyPressEvent &event) {
 
 void UserScalePage::setSelectedIndex(int index) {
     _selectedIndex = index;
-    _userScale = &UserScale::userScales[index];
+    _userScale = &_project.userScale(index);
     _listModel.setUserScale(*_userScale);
 }
 
@@ -118,7 +118,7 @@ bool UserScalePage::contextActionEnabled(int index) const {
         return _model.clipBoard().canPasteUserScale();
     case ContextAction::Load:
     case ContextAction::Save:
-        return FileManager::volumeMounted();
+        return _context.fileManager.volumeMounted();
     default:
         return true;
     }
@@ -154,7 +154,7 @@ void UserScalePage::loadUserScale() {
 void UserScalePage::saveUserScale() {
     _manager.pages().fileSelect.show("SAVE SCALE", FileType::UserScale, 0, true, [this] (bool result, int slot) {
         if (result) {
-            if (FileManager::slotUsed(FileType::UserScale, slot)) {
+            if (_context.fileManager.slotUsed(FileType::UserScale, slot)) {
                 _manager.pages().confirmation.show("ARE YOU SURE?", [this, slot] (bool result) {
                     if (result) {
                         saveUserScaleToSlot(slot);
@@ -168,29 +168,20 @@ void UserScalePage::saveUserScale() {
 }
 
 void UserScalePage::saveUserScaleToSlot(int slot) {
-    _engine.lock();
-    _manager.pages().busy.show("SAVING USER SCALE ...");
-
-    FileManager::task([this, slot] () {
-        return FileManager::saveUserScale(*_userScale, slot);
+    fileTask("SAVING USER SCALE ...", [this, slot] () {
+        return _context.fileManager.saveUserScale(*_userScale, slot);
     }, [this] (fs::Error result) {
         if (result == fs::OK) {
             showMessage("USER SCALE SAVED");
         } else {
             showMessage(FixedStringBuilder<32>("FAILED (%s)", fs::errorToString(result)));
         }
-        // TODO lock ui mutex
-        _manager.pages().busy.close();
-        _engine.unlock();
     });
 }
 
 void UserScalePage::loadUserScaleFromSlot(int slot) {
-    _engine.lock();
-    _manager.pages().busy.show("LOADING USER SCALE ...");
-
-    FileManager::task([this, slot] () {
-        return FileManager::loadUserScale(*_userScale, slot);
+    fileTask("LOADING USER SCALE ...", [this, slot] () {
+        return _context.fileManager.loadUserScale(*_userScale, slot);
     }, [this] (fs::Error result) {
         if (result == fs::OK) {
             showMessage("USER SCALE LOADED");
@@ -199,8 +190,5 @@ void UserScalePage::loadUserScaleFromSlot(int slot) {
         } else {
             showMessage(FixedStringBuilder<32>("FAILED (%s)", fs::errorToString(result)));
         }
-        // TODO lock ui mutex
-        _manager.pages().busy.close();
-        _engine.unlock();
     });
 }
@@ -465,8 +465,8 @@ private:
     std::array<int, 8> _cvOutputs;
     std::array<bool, 8> _gateOutputs;
 
-    uint8_t _frameBufferData[256 * 64];
-    FrameBuffer8bit _frameBuffer;
+    uint8_t _frameBufferData[256 * 64 / 2];
+    FrameBuffer4bit _frameBuffer;
     Canvas _canvas;
 };
 
@@ -1,23 +1,127 @@
 #pragma once
 
+#include "FrameBuffer.h"
+
+#include <algorithm>
+
 #include <cstdint>
+#include <cstring>
 
+// Blit kernels for packed 4bpp frame buffers.
+// Single pixels are updated in place within their nibble pair, horizontal
+// spans are processed 8 pixels at a time on 32-bit words. Results are
+// saturated to the 4 bit range.
 namespace blit {
+    namespace detail {
+        inline uint8_t &pair(FrameBuffer4bit &frameBuffer, int x, int y) {
+            return frameBuffer.row(y)[x >> 1];
+        }
+        inline int shift(int x) {
+            return (x & 1) ? 0 : 4;
+        }
+
+        static constexpr uint32_t NibbleMask = 0x0f0f0f0f;
+        static constexpr uint32_t CarryMask = 0x10101010;
+
+        // turns the carry bit of each lane into a 4 bit mask
+        inline uint32_t carryToMask(uint32_t value) {
+            return ((value & CarryMask) >> 4) * 0xf;
+        }
+    } // namespace detail
+
+    // Each kernel provides a pixel operator and a word operation applying
+    // the blend to 8 nibbles in parallel. The word operation is lane local,
+    // so it can also be used on single bytes or with per pixel colors.
     struct set {
-        void operator()(FrameBuffer8bit &frameBuffer, int x, int y, uint8_t color) {
-            frameBuffer(x, y) = color;
+        void operator()(FrameBuffer4bit &frameBuffer, int x, int y, uint8_t color) {
+            uint8_t &pair = detail::pair(frameBuffer, x, y);
+            int shift = detail::shift(x);
+            uint8_t value = std::min(color, uint8_t(FrameBuffer4bit::MaxValue));
+            pair = (pair & ~(0xf << shift)) | (value << shift);
+        }
+        static uint32_t word(uint32_t dst, uint32_t color) {
+            return color;
         }
     };
     struct add {
-        void operator()(FrameBuffer8bit &frameBuffer, int x, int y, uint8_t color) {
-            // frameBuffer(x, y) = std::min(0xff, int(frameBuffer(x, y)) + color);
-            frameBuffer(x, y) += color;
+        void operator()(FrameBuffer4bit &frameBuffer, int x, int y, uint8_t color) {
+            uint8_t &pair = detail::pair(frameBuffer, x, y);
+            int shift = detail::shift(x);
+            int value = std::min(int(FrameBuffer4bit::MaxValue), ((pair >> shift) & 0xf) + color);
+            pair = (pair & ~(0xf << shift)) | (value << shift);
+        }
+        static uint32_t word(uint32_t dst, uint32_t color) {
+            using namespace detail;
+            uint32_t lo = (dst & NibbleMask) + (color & NibbleMask);
+            uint32_t hi = ((dst >> 4) & NibbleMask) + ((color >> 4) & NibbleMask);
+            lo = (lo | carryToMask(lo)) & NibbleMask;
+            hi = (hi | carryToMask(hi)) & NibbleMask;
+            return lo | (hi << 4);
         }
     };
     struct sub {
-        void operator()(FrameBuffer8bit &frameBuffer, int x, int y, uint8_t color) {
-            // frameBuffer(x, y) = std::max(0x00, int(frameBuffer(x, y)) - color);
-            frameBuffer(x, y) -= std::min(frameBuffer(x, y), color);
+        void operator()(FrameBuffer4bit &frameBuffer, int x, int y, uint8_t color) {
+            uint8_t &pair = detail::pair(frameBuffer, x, y);
+            int shift = detail::shift(x);
+            int value = std::max(0, ((pair >> shift) & 0xf) - color);
+            pair = (pair & ~(0xf << shift)) | (value << shift);
+        }
+        static uint32_t word(uint32_t dst, uint32_t color) {
+            using namespace detail;
+            // lanes without carry bit left underflowed and are cleared
+            uint32_t lo = ((dst & NibbleMask) | CarryMask) - (color & NibbleMask);
+            uint32_t hi = (((dst >> 4) & NibbleMask) | CarryMask) - ((color >> 4) & NibbleMask);
+            lo &= carryToMask(lo);
+            hi &= carryToMask(hi);
+            return lo | (hi << 4);
         }
     };
+
+    // blends the pixels x0..x1 (inclusive, already clipped) of row y
+    template<typename Blit>
+    void span(FrameBuffer4bit &frameBuffer, int x0, int x1, int y, uint8_t color) {
+        Blit blit;
+        color = std::min(color, uint8_t(FrameBuffer4bit::MaxValue));
+
+        // unaligned end pixels
+        if (x0 & 1) {
+            blit(frameBuffer, x0++, y, color);
+        }
+        if (x0 <= x1 && !(x1 & 1)) {
+            blit(frameBuffer, x1--, y, color);
+        }
+        if (x0 > x1) {
+            return;
+        }
+
+        // whole nibble pairs
+        uint32_t pattern = color * 0x11111111u;
+        uint8_t *p = frameBuffer.row(y) + (x0 >> 1);
+        uint8_t *end = frameBuffer.row(y) + (x1 >> 1) + 1;
+        for (; end - p >= 4; p += 4) {
+            uint32_t word;
+            std::memcpy(&word, p, 4);
+            word = Blit::word(word, pattern);
+            std::memcpy(p, &word, 4);
+        }
+        for (; p < end; ++p) {
+            *p = Blit::word(*p, pattern);
+        }
+    }
+
+    // blends a row of pre-rendered pixels into dst, only nibbles set in mask are written
+    template<typename Blit>
+    void masked(uint8_t *dst, const uint8_t *src, const uint8_t *mask, int bytes) {
+        for (; bytes >= 4; bytes -= 4, dst += 4, src += 4, mask += 4) {
+            uint32_t d, s, m;
+            std::memcpy(&d, dst, 4);
+            std::memcpy(&s, src, 4);
+            std::memcpy(&m, mask, 4);
+            d = (d & ~m) | (Blit::word(d, s) & m);
+            std::memcpy(dst, &d, 4);
+        }
+        for (; bytes > 0; --bytes, ++dst, ++src, ++mask) {
+            *dst = (*dst & ~*mask) | (Blit::word(*dst, *src) & *mask);
+        }
+    }
 };
@@ -1,11 +1,18 @@
 #include "Canvas.h"
 #include "Blit.h"
 
+#include "core/hash/FnvHash.h"
+
+#include <algorithm>
+
+#include <cstring>
 #include <stdio.h>
 
 // Font definitions
 #include "fonts/tiny5x5.h"
+#include "fonts/tiny5x5_strips.h"
 #include "fonts/ati8x8.h"
+#include "fonts/ati8x8_strips.h"
 
 static const BitmapFont &bitmapFont(Font font) {
     switch (font) {
@@ -31,6 +38,46 @@ static const int bitmapFontOffset(Font font) {
     }
 }
 
+// Glyph bitmaps as row masks (bit n = column n), so glyphs are drawn without
+// decoding the packed font bitmap bit by bit. The tables are kept in flash.
+typedef uint8_t GlyphRows[8];
+
+static const GlyphRows *glyphStrips(Font font) {
+    switch (font) {
+    case Font::Tiny: return tiny5x5_strips;
+    case Font::Small: return ati8x8_strips;
+    default: return tiny5x5_strips;
+    }
+}
+
+// calls f(x, glyph) for each glyph of a single line of text
+template<typename F>
+static void forEachGlyph(const BitmapFont &font, const char *str, F f) {
+    int x = 0;
+    while (*str != '\0') {
+        auto c = *str++;
+        if (c < font.first || c > font.last) {
+            continue;
+        }
+        const auto &g = font.glyphs[c - font.first];
+        f(x, g);
+        x += g.xAdvance;
+    }
+}
+
+// returns false if the text cannot be cached
+static bool hashText(const char *str, uint32_t &result) {
+    FnvHash hash;
+    for (int length = 0; str[length] != '\0'; ++length) {
+        if (str[length] == '\n' || length >= TextCache::MaxLength) {
+            return false;
+        }
+        hash(uint8_t(str[length]));
+    }
+    result = hash.result();
+    return true;
+}
+
 
 void Canvas::fill() {
     _frameBuffer.fill(_color);
@@ -101,27 +148,10 @@ void Canvas::drawBitmap4bit(int x, int y, int w, int h, const uint8_t *bitmap) {
 }
 
 void Canvas::drawText(int x, int y, const char *str) {
-    const auto &font = bitmapFont(_font);
-
-    int ox = x;
-    while (*str != '\0') {
-        auto c = *str++;
-        if (c == '\n') {
-            x = ox;
-            y += font.yAdvance;
-            continue;
-        }
-        if (c < font.first || c > font.last) {
-            continue;
-        }
-        const auto &g = font.glyphs[c - font.first];
-        const uint8_t *bitmap = &font.bitmap[g.offset];
-        switch (font.bpp) {
-        case 1: drawBitmap1bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
-        case 4: drawBitmap4bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
-        }
-        x += g.xAdvance;
+    if (_textCache && drawCachedText(x, y, str)) {
+        return;
     }
+    drawGlyphs(x, y, str);
 }
 
 void Canvas::drawTextCentered(int x, int y, int w, int h, const char *str) {
@@ -159,6 +189,7 @@ void Canvas::drawTextAligned(int x, int y, int w, int h, HorizontalAlign horizon
 
 void Canvas::drawTextMultiline(int x, int y, int w, const char *str) {
     const auto &font = bitmapFont(_font);
+    const auto *strips = glyphStrips(_font);
 
     int ox = x;
     while (*str != '\0') {
@@ -178,16 +209,20 @@ void Canvas::drawTextMultiline(int x, int y, int w, const char *str) {
             str--;
             continue;
         }
-        const uint8_t *bitmap = &font.bitmap[g.offset];
-        switch (font.bpp) {
-        case 1: drawBitmap1bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
-        case 4: drawBitmap4bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
-        }
+        drawGlyph(x + g.xOffset, y + g.yOffset, g.width, g.height, strips[c - font.first]);
         x += g.xAdvance;
     }
 }
 
 int Canvas::textWidth(const char *str) {
+    uint32_t hash;
+    if (_textCache && hashText(str, hash)) {
+        TextCache::Key key = { hash, uint32_t(_font), str };
+        if (const auto *run = _textCache->findText(key)) {
+            return run->textWidth;
+        }
+    }
+
     const auto &font = bitmapFont(_font);
     int width = 0;
 
@@ -217,3 +252,120 @@ int Canvas::textHeight(const char *str) {
     return height;
 }
 
+
+void Canvas::drawGlyphs(int x, int y, const char *str) {
+    const auto &font = bitmapFont(_font);
+    const auto *strips = glyphStrips(_font);
+
+    int ox = x;
+    while (*str != '\0') {
+        auto c = *str++;
+        if (c == '\n') {
+            x = ox;
+            y += font.yAdvance;
+            continue;
+        }
+        if (c < font.first || c > font.last) {
+            continue;
+        }
+        const auto &g = font.glyphs[c - font.first];
+        drawGlyph(x + g.xOffset, y + g.yOffset, g.width, g.height, strips[c - font.first]);
+        x += g.xAdvance;
+    }
+}
+
+bool Canvas::drawCachedText(int x, int y, const char *str) {
+    const auto &font = bitmapFont(_font);
+
+    uint32_t hash;
+    if (!hashText(str, hash)) {
+        return false;
+    }
+
+    int parity = x & 1;
+    uint32_t style = uint32_t(_font) | (uint32_t(_color) << 8) | (uint32_t(_blendMode) << 16) | (uint32_t(parity) << 24);
+    TextCache::Key key = { hash, style, str };
+
+    auto inside = [this] (int x0, int y0, int w, int h) {
+        return x0 >= 0 && x0 + w - 1 <= _right && y0 >= 0 && y0 + h - 1 <= _bottom;
+    };
+
+    const auto *run = _textCache->find(key);
+    if (!run) {
+        auto *admitted = _textCache->admit(key);
+        if (!admitted) {
+            return false;
+        }
+
+        // bounding box of all glyphs relative to the cursor
+        int x0 = 0, x1 = -1, y0 = 0, y1 = -1;
+        int textWidth = 0;
+        forEachGlyph(font, str, [&] (int gx, const BitmapFontGlyph &g) {
+            textWidth = gx + g.xAdvance;
+            if (g.width == 0 || g.height == 0) {
+                return;
+            }
+            int gx0 = gx + g.xOffset, gy0 = g.yOffset;
+            int gx1 = gx0 + g.width - 1, gy1 = gy0 + g.height - 1;
+            bool empty = x1 < x0;
+            x0 = empty ? gx0 : std::min(x0, gx0);
+            y0 = empty ? gy0 : std::min(y0, gy0);
+            x1 = empty ? gx1 : std::max(x1, gx1);
+            y1 = empty ? gy1 : std::max(y1, gy1);
+        });
+        if (x1 < x0) {
+            // nothing to draw
+            return true;
+        }
+
+        // runs start at an even pixel so they can be blended by whole bytes
+        int left = x0 - ((x + x0) & 1);
+        int width = x1 - left + 1;
+        int height = y1 - y0 + 1;
+        if (width > TextCache::Stride * 2 || height > TextCache::MaxHeight || !inside(x + left, y + y0, width, height)) {
+            return false;
+        }
+
+        auto &newRun = _textCache->allocate(*admitted, key);
+        newRun.left = left;
+        newRun.top = y0;
+        newRun.width = width;
+        newRun.height = height;
+        newRun.textWidth = textWidth;
+
+        // Add and Sub both accumulate the run, so blending it once matches blending every glyph
+        FrameBuffer4bit pixels(TextCache::Stride * 2, TextCache::MaxHeight, newRun.pixels);
+        Canvas pixelCanvas(pixels);
+        pixelCanvas.setFont(_font);
+        pixelCanvas.setColor(_color);
+        pixelCanvas.setBlendMode(_blendMode == BlendMode::Set ? BlendMode::Set : BlendMode::Add);
+        pixelCanvas.drawGlyphs(-left, -y0, str);
+
+        FrameBuffer4bit coverage(TextCache::Stride * 2, TextCache::MaxHeight, newRun.coverage);
+        Canvas coverageCanvas(coverage);
+        coverageCanvas.setColor(0xf);
+        forEachGlyph(font, str, [&] (int gx, const BitmapFontGlyph &g) {
+            coverageCanvas.fillRect(gx + g.xOffset - left, g.yOffset - y0, g.width, g.height);
+        });
+
+        run = &newRun;
+    } else if (!inside(x + run->left, y + run->top, run->width, run->height)) {
+        return false;
+    }
+
+    switch (_blendMode) {
+    case BlendMode::Set: drawRun<blit::set>(x + run->left, y + run->top, *run); break;
+    case BlendMode::Add: drawRun<blit::add>(x + run->left, y + run->top, *run); break;
+    case BlendMode::Sub: drawRun<blit::sub>(x + run->left, y + run->top, *run); break;
+    }
+
+    return true;
+}
+
+void Canvas::drawGlyph(int x, int y, int w, int h, const uint8_t *rows) {
+    switch (_blendMode) {
+    case BlendMode::Set: drawGlyph<blit::set>(x, y, w, h, rows); break;
+    case BlendMode::Add: drawGlyph<blit::add>(x, y, w, h, rows); break;
+    case BlendMode::Sub: drawGlyph<blit::sub>(x, y, w, h, rows); break;
+    }
+}
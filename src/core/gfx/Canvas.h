@@ -1,6 +1,8 @@
 #pragma once
 
 #include "FrameBuffer.h"
+#include "Blit.h"
+#include "TextCache.h"
 
 #include <algorithm>
 
@@ -33,7 +35,7 @@ enum class VerticalAlign {
 
 class Canvas {
 public:
-    Canvas(FrameBuffer8bit &frameBuffer) :
+    Canvas(FrameBuffer4bit &frameBuffer) :
         _frameBuffer(frameBuffer),
         _right(frameBuffer.width() - 1),
         _bottom(frameBuffer.height() - 1)
@@ -49,6 +51,10 @@ public:
     Font font() const { return _font; }
     void setFont(Font font) { _font = font; }
 
+    // optional cache for rendered text runs, owned by the caller
+    TextCache *textCache() const { return _textCache; }
+    void setTextCache(TextCache *textCache) { _textCache = textCache; }
+
     void fill();
 
     void point(int x, int y);
@@ -74,17 +80,22 @@ public:
 
 
 private:
-    void hclip(int &x) {
-        x = std::max(0, std::min(_right, x));
-    }
-
-    void vclip(int &y) {
-        y = std::max(0, std::min(_bottom, y));
+    void drawGlyphs(int x, int y, const char *str);
+    bool drawCachedText(int x, int y, const char *str);
+    void drawGlyph(int x, int y, int w, int h, const uint8_t *rows);
+
+    // clips a horizontal span, returns false if it is outside
+    bool hclip(int &x0, int &x1) {
+        x0 = std::max(0, x0);
+        x1 = std::min(_right, x1);
+        return x0 <= x1;
     }
 
-    void clip(int &x, int &y) {
-        hclip(x);
-        vclip(y);
+    // clips a vertical span, returns false if it is outside
+    bool vclip(int &y0, int &y1) {
+        y0 = std::max(0, y0);
+        y1 = std::min(_bottom, y1);
+        return y0 <= y1;
     }
 
     bool hinside(int x) {
@@ -109,44 +120,47 @@ private:
 
     template<typename Blit>
     void hline(int x, int y, int w) {
-        Blit blit;
-        if (vinside(y)) {
-            int x0 = x, x1 = x + w - 1;
-            hclip(x0);
-            hclip(x1);
-            for (int x = x0; x <= x1; ++x) {
-                blit(_frameBuffer, x, y, _color);
-            }
+        int x0 = x, x1 = x + w - 1;
+        if (vinside(y) && hclip(x0, x1)) {
+            blit::span<Blit>(_frameBuffer, x0, x1, y, _color);
         }
     }
 
     template<typename Blit>
     void vline(int x, int y, int h) {
         Blit blit;
-        if (hinside(x)) {
-            int y0 = y, y1 = y + h - 1;
-            vclip(y0);
-            vclip(y1);
+        int y0 = y, y1 = y + h - 1;
+        if (hinside(x) && vclip(y0, y1)) {
             for (int y = y0; y <= y1; ++y) {
                 blit(_frameBuffer, x, y, _color);
             }
         }
     }
 
+    // anti-aliased line (Xiaolin Wu) using 16.16 fixed point stepping
     template<typename Blit>
-    void line(float x0, float y0, float x1, float y1) {
+    void line(float fx0, float fy0, float fx1, float fy1) {
         Blit blit;
 
-        auto plot = [&] (int x, int y, float c) {
+        typedef int32_t Fixed;
+        const int FracBits = 16;
+        const Fixed One = Fixed(1) << FracBits;
+        const Fixed Half = One >> 1;
+
+        auto plot = [&] (int x, int y, Fixed c) {
             if (inside(x, y)) {
-                blit(_frameBuffer, x, y, _color * c);
+                blit(_frameBuffer, x, y, (_color * c) >> FracBits);
             }
         };
 
-        auto ipart = [] (float x) { return std::floor(x); };
-        auto round = [] (float x) { return std::floor(x + 0.5f); };
-        auto fpart = [] (float x) { return x - std::floor(x); };
-        auto rfpart = [] (float x) { return 1.f - (x - std::floor(x)); };
+        auto ipart = [] (Fixed x) { return x >> FracBits; };
+        auto round = [&] (Fixed x) { return (x + Half) >> FracBits; };
+        auto fpart = [&] (Fixed x) { return x & (One - 1); };
+        auto rfpart = [&] (Fixed x) { return One - (x & (One - 1)); };
+        auto mul = [] (Fixed a, Fixed b) { return Fixed((int64_t(a) * b) >> FracBits); };
+
+        Fixed x0 = fx0 * One, y0 = fy0 * One;
+        Fixed x1 = fx1 * One, y1 = fy1 * One;
 
         bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
 
@@ -159,37 +173,37 @@ private:
             std::swap(y0, y1);
         }
 
-        float dx = x1 - x0;
-        float dy = y1 - y0;
-        float gradient = dx == 0.f ? 1.f : dy / dx;
+        Fixed dx = x1 - x0;
+        Fixed dy = y1 - y0;
+        Fixed gradient = dx == 0 ? One : Fixed((int64_t(dy) * One) / dx);
 
         // first endpoint
         int xend = round(x0);
-        float yend = y0 + gradient * (xend - x0);
-        float xgap = rfpart(x0 + 0.5f);
+        Fixed yend = y0 + mul(gradient, xend * One - x0);
+        Fixed xgap = rfpart(x0 + Half);
         int xpxl1 = xend;
         int ypxl1 = ipart(yend);
         if (steep) {
-            plot(ypxl1,     xpxl1, rfpart(yend) * xgap);
-            plot(ypxl1 + 1, xpxl1,  fpart(yend) * xgap);
+            plot(ypxl1,     xpxl1, mul(rfpart(yend), xgap));
+            plot(ypxl1 + 1, xpxl1, mul( fpart(yend), xgap));
         } else {
-            plot(xpxl1, ypxl1,     rfpart(yend) * xgap);
-            plot(xpxl1, ypxl1 + 1,  fpart(yend) * xgap);
+            plot(xpxl1, ypxl1,     mul(rfpart(yend), xgap));
+            plot(xpxl1, ypxl1 + 1, mul( fpart(yend), xgap));
         }
-        float intery = yend + gradient;
+        Fixed intery = yend + gradient;
 
         // second endpoint
         xend = round(x1);
-        yend = y1 + gradient * (xend - x1);
-        xgap = fpart(x1 + 0.5f);
+        yend = y1 + mul(gradient, xend * One - x1);
+        xgap = fpart(x1 + Half);
         int xpxl2 = xend;
         int ypxl2 = ipart(yend);
         if (steep) {
-            plot(ypxl2,     xpxl2, rfpart(yend) * xgap);
-            plot(ypxl2 + 1, xpxl2,  fpart(yend) * xgap);
+            plot(ypxl2,     xpxl2, mul(rfpart(yend), xgap));
+            plot(ypxl2 + 1, xpxl2, mul( fpart(yend), xgap));
         } else {
-            plot(xpxl2, ypxl2,    rfpart(yend) * xgap);
-            plot(xpxl2, ypxl2 + 1, fpart(yend) * xgap);
+            plot(xpxl2, ypxl2,     mul(rfpart(yend), xgap));
+            plot(xpxl2, ypxl2 + 1, mul( fpart(yend), xgap));
         }
 
         // main loop
@@ -197,35 +211,32 @@ private:
             for (int x = xpxl1 + 1; x < xpxl2; ++x) {
                 plot(ipart(intery),     x, rfpart(intery));
                 plot(ipart(intery) + 1, x,  fpart(intery));
-                intery = intery + gradient;
+                intery += gradient;
             }
         } else {
             for (int x = xpxl1 + 1; x < xpxl2; ++x) {
-                plot(x, ipart(intery),    rfpart(intery));
-                plot(x, ipart(intery) + 1, fpart(intery));
-                intery = intery + gradient;
+                plot(x, ipart(intery),     rfpart(intery));
+                plot(x, ipart(intery) + 1,  fpart(intery));
+                intery += gradient;
             }
         }
     }
 
     template<typename Blit>
     void drawRect(int x, int y, int w, int h) {
-        hline(x, y, w);
-        hline(x, y + h - 1, w);
-        vline(x, y + 1, h - 2);
-        vline(x + w - 1, y + 1, h - 2);
+        hline<Blit>(x, y, w);
+        hline<Blit>(x, y + h - 1, w);
+        vline<Blit>(x, y + 1, h - 2);
+        vline<Blit>(x + w - 1, y + 1, h - 2);
     }
 
     template<typename Blit>
     void fillRect(int x, int y, int w, int h) {
-        Blit blit;
         int x0 = x, x1 = x + w - 1;
         int y0 = y, y1 = y + h - 1;
-        clip(x0, y0);
-        clip(x1, y1);
-        for (int y = y0; y <= y1; ++y) {
-            for (int x = x0; x <= x1; ++x) {
-                blit(_frameBuffer, x, y, _color);
+        if (hclip(x0, x1) && vclip(y0, y1)) {
+            for (int y = y0; y <= y1; ++y) {
+                blit::span<Blit>(_frameBuffer, x0, x1, y, _color);
             }
         }
     }
@@ -235,32 +246,54 @@ private:
         Blit blit;
         int x0 = x, x1 = x + w - 1;
         int y0 = y, y1 = y + h - 1;
-        if (x0 > _right || x1 < 0 || y0 > _bottom || y1 < 0) {
+        if (!hclip(x0, x1) || !vclip(y0, y1)) {
             return;
         }
 
+        // pixels are packed lsb first and never straddle a byte
         const uint8_t mask = (1 << Bpp) - 1;
-        int shift = 0;
-        for (int y = y0; y <= y1; ++y) {
-            for (int x = x0; x <= x1; ++x) {
-                // uint8_t pixel = ((*bitmap >> shift) & mask) << (8 - Bpp);
-                uint8_t pixel = ((*bitmap >> shift) & mask) * _color;
-                shift += Bpp;
-                if (shift >= 8) {
-                    ++bitmap;
-                    shift = 0;
-                }
-                if (inside(x, y)) {
-                    blit(_frameBuffer, x, y, pixel);
-                }
+        for (int py = y0; py <= y1; ++py) {
+            int bit = ((py - y) * w + (x0 - x)) * Bpp;
+            for (int px = x0; px <= x1; ++px, bit += Bpp) {
+                uint8_t pixel = ((bitmap[bit >> 3] >> (bit & 7)) & mask) * _color;
+                blit(_frameBuffer, px, py, pixel);
+            }
+        }
+    }
+
+    // draws a glyph given as row masks (bit n = column n)
+    template<typename Blit>
+    void drawGlyph(int x, int y, int w, int h, const uint8_t *rows) {
+        Blit blit;
+        int x0 = x, x1 = x + w - 1;
+        int y0 = y, y1 = y + h - 1;
+        if (!hclip(x0, x1) || !vclip(y0, y1)) {
+            return;
+        }
+
+        for (int py = y0; py <= y1; ++py) {
+            uint8_t bits = rows[py - y] >> (x0 - x);
+            for (int px = x0; px <= x1; ++px, bits >>= 1) {
+                blit(_frameBuffer, px, py, (bits & 1) ? _color : 0);
             }
         }
     }
 
-    FrameBuffer8bit &_frameBuffer;
+    // blends a cached text run starting at the even pixel column x
+    template<typename Blit>
+    void drawRun(int x, int y, const TextCache::Run &run) {
+        int bytes = (run.width + 1) / 2;
+        for (int row = 0; row < run.height; ++row) {
+            int offset = row * TextCache::Stride;
+            blit::masked<Blit>(_frameBuffer.row(y + row) + (x >> 1), &run.pixels[offset], &run.coverage[offset], bytes);
+        }
+    }
+
+    FrameBuffer4bit &_frameBuffer;
     int _right;
     int _bottom;
     uint8_t _color = 0xf;
     BlendMode _blendMode = BlendMode::Set;
     Font _font = Font::Default;
+    TextCache *_textCache = nullptr;
 };
@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include <cstdint>
+#include <cstring>
 
 template<typename T>
 class FrameBuffer {
@@ -46,3 +47,60 @@ private:
 };
 
 typedef FrameBuffer<uint8_t> FrameBuffer8bit;
+
+// Frame buffer with 4 bits per pixel, packing two horizontally adjacent pixels
+// into each byte. The left pixel is stored in the high nibble, which is the
+// memory layout of the display controller, so frames can be sent as is.
+class FrameBuffer4bit {
+public:
+    static constexpr uint8_t MaxValue = 0xf;
+
+    FrameBuffer4bit(int width, int height, uint8_t *buffer) :
+        _width(width),
+        _height(height),
+        _stride(width / 2),
+        _size(_stride * height),
+        _data(buffer)
+    {}
+
+    int width() const { return _width; }
+    int height() const { return _height; }
+
+    // number of bytes per row
+    int stride() const { return _stride; }
+    // number of bytes in the buffer
+    int size() const { return _size; }
+
+    const uint8_t *data() const { return _data; }
+          uint8_t *data()       { return _data; }
+
+    const uint8_t *row(int y) const { return &_data[y * _stride]; }
+          uint8_t *row(int y)       { return &_data[y * _stride]; }
+
+    void fill(uint8_t value) {
+        value = std::min(value, uint8_t(MaxValue));
+        std::memset(_data, (value << 4) | value, _size);
+    }
+
+    uint8_t get(int x, int y) const {
+        uint8_t pair = _data[y * _stride + (x >> 1)];
+        return (x & 1) ? pair & 0xf : pair >> 4;
+    }
+
+    // value must be in range 0..MaxValue
+    void set(int x, int y, uint8_t value) {
+        uint8_t &pair = _data[y * _stride + (x >> 1)];
+        pair = (x & 1) ? (pair & 0xf0) | value : (pair & 0x0f) | (value << 4);
+    }
+
+    uint8_t operator()(int x, int y) const {
+        return get(x, y);
+    }
+
+private:
+    int _width;
+    int _height;
+    int _stride;
+    int _size;
+    uint8_t *_data;
+};
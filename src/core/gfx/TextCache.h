@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// Cache of rendered text runs.
+// A run holds the 4bpp pixels of a rendered string together with a coverage
+// mask of its glyph boxes. Redrawing an unchanged label blends the run a word
+// at a time instead of rasterizing each glyph again. The text width is kept
+// with the run, so aligning cached labels does not measure them again.
+// Pages draw more labels per frame than there are runs, so rendering a run is
+// only worth it for strings that repeat: a string is only admitted once it was
+// seen before, and it only replaces a run that was not used in the current or
+// previous frame. Everything else is drawn directly. Call nextFrame() once per
+// frame, otherwise runs are never replaced once all of them are used.
+class TextCache {
+public:
+    static constexpr int Size = 4;
+    static constexpr int SeenSize = 32;
+    static constexpr int MaxLength = 16;
+    static constexpr int MaxWidth = 64;
+    static constexpr int MaxHeight = 10;
+    // one extra byte for runs starting at an odd pixel
+    static constexpr int Stride = MaxWidth / 2 + 1;
+
+    // identifies a run, style packs font (lowest byte), color, blend mode and pixel parity
+    struct Key {
+        uint32_t hash;
+        uint32_t style;
+        const char *text;
+    };
+
+    struct Run {
+        uint32_t hash;
+        uint32_t style;
+        char text[MaxLength + 1];
+        int8_t left;                // x offset of the first pixel column relative to the cursor
+        int8_t top;                 // y offset of the first row relative to the cursor
+        uint8_t width;              // width in pixels, including the parity column
+        uint8_t height;             // height in rows
+        uint8_t textWidth;          // sum of glyph advances
+        uint32_t lastUsed;
+        uint32_t lastFrame;
+        uint8_t pixels[MaxHeight * Stride];
+        uint8_t coverage[MaxHeight * Stride];
+    };
+
+    void nextFrame() {
+        ++_frame;
+    }
+
+    // returns the cached run or nullptr
+    const Run *find(const Key &key) {
+        for (auto &run : _runs) {
+            if (run.lastUsed != 0 && run.hash == key.hash && run.style == key.style && std::strcmp(run.text, key.text) == 0) {
+                touch(run);
+                return &run;
+            }
+        }
+        return nullptr;
+    }
+
+    // returns a cached run of the same text and font in any style or nullptr
+    const Run *findText(const Key &key) {
+        for (auto &run : _runs) {
+            if (run.lastUsed != 0 && run.hash == key.hash && (run.style & 0xff) == (key.style & 0xff) && std::strcmp(run.text, key.text) == 0) {
+                touch(run);
+                return &run;
+            }
+        }
+        return nullptr;
+    }
+
+    // returns the run to replace with a key that was not found or nullptr if the key is not admitted
+    Run *admit(const Key &key) {
+        uint32_t seen = key.hash ^ (key.style * 0x9e3779b1u);
+        auto &slot = _seen[seen % SeenSize];
+        if (slot != seen) {
+            slot = seen;
+            return nullptr;
+        }
+
+        Run *victim = nullptr;
+        for (auto &run : _runs) {
+            if (run.lastUsed == 0) {
+                return &run;
+            }
+            if (_frame - run.lastFrame > 1 && (!victim || run.lastUsed < victim->lastUsed)) {
+                victim = &run;
+            }
+        }
+        return victim;
+    }
+
+    // returns the admitted run cleared for the given key
+    Run &allocate(Run &run, const Key &key) {
+        run.hash = key.hash;
+        run.style = key.style;
+        std::strncpy(run.text, key.text, MaxLength);
+        run.text[MaxLength] = '\0';
+        touch(run);
+        std::memset(run.pixels, 0, sizeof(run.pixels));
+        std::memset(run.coverage, 0, sizeof(run.coverage));
+        return run;
+    }
+
+    void clear() {
+        for (auto &run : _runs) {
+            run.style = 0;
+            run.text[0] = '\0';
+            run.lastUsed = 0;
+        }
+        std::memset(_seen, 0, sizeof(_seen));
+    }
+
+private:
+    void touch(Run &run) {
+        run.lastUsed = ++_useCounter;
+        run.lastFrame = _frame;
+    }
+
+    Run _runs[Size] = {};
+    uint32_t _seen[SeenSize] = {};
+    uint32_t _useCounter = 0;
+    uint32_t _frame = 0;
+};
@@ -0,0 +1,121 @@
+#ifndef __ATI8X8_STRIPS_H__
+#define __ATI8X8_STRIPS_H__
+
+#include <stdint.h>
+
+// Glyph bitmaps of ati8x8 as row masks (bit n = column n), one row of 8 bytes per glyph
+static const uint8_t ati8x8_strips[][8] = {
+    { 0x01, 0x03, 0x0f, 0x1f, 0x0f, 0x03, 0x01, 0x00 }, // 0x10
+    { 0x10, 0x18, 0x1e, 0x1f, 0x1e, 0x18, 0x10, 0x00 }, // 0x11
+    { 0x0c, 0x1e, 0x3f, 0x0c, 0x3f, 0x1e, 0x0c, 0x00 }, // 0x12
+    { 0x33, 0x33, 0x33, 0x33, 0x33, 0x00, 0x33, 0x00 }, // 0x13
+    { 0xfe, 0xdb, 0xde, 0xdc, 0xd8, 0xd8, 0xd8, 0x00 }, // 0x14
+    { 0x3c, 0x66, 0x1c, 0x36, 0x36, 0x1c, 0x33, 0x1e }, // 0x15
+    { 0x7f, 0x7f, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00 }, // 0x16
+    { 0x0c, 0x1e, 0x3f, 0x0c, 0x3f, 0x1e, 0x0c, 0x3f }, // 0x17
+    { 0x0c, 0x1e, 0x3f, 0x0c, 0x0c, 0x0c, 0x0c, 0x00 }, // 0x18
+    { 0x0c, 0x0c, 0x0c, 0x0c, 0x3f, 0x1e, 0x0c, 0x00 }, // 0x19
+    { 0x18, 0x38, 0x7f, 0x38, 0x18, 0x00, 0x00, 0x00 }, // 0x1a
+    { 0x0c, 0x0e, 0x7f, 0x0e, 0x0c, 0x00, 0x00, 0x00 }, // 0x1b
+    { 0x03, 0x03, 0x03, 0x7f, 0x00, 0x00, 0x00, 0x00 }, // 0x1c
+    { 0x24, 0x66, 0xff, 0x66, 0x24, 0x00, 0x00, 0x00 }, // 0x1d
+    { 0x08, 0x1c, 0x3e, 0x3e, 0x7f, 0x00, 0x00, 0x00 }, // 0x1e
+    { 0x7f, 0x3e, 0x3e, 0x1c, 0x08, 0x00, 0x00, 0x00 }, // 0x1f
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+    { 0x06, 0x0f, 0x0f, 0x06, 0x06, 0x00, 0x06, 0x00 }, // '!'
+    { 0x1b, 0x1b, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '"'
+    { 0x36, 0x36, 0x7f, 0x36, 0x7f, 0x36, 0x36, 0x00 }, // '#'
+    { 0x18, 0x7e, 0x03, 0x3e, 0x60, 0x3f, 0x18, 0x00 }, // '$'
+    { 0x63, 0x30, 0x18, 0x0c, 0x06, 0x63, 0x00, 0x00 }, // '%'
+    { 0x1c, 0x36, 0x1c, 0x6e, 0x33, 0x33, 0x6e, 0x00 }, // '&'
+    { 0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '''
+    { 0x0c, 0x06, 0x03, 0x03, 0x03, 0x06, 0x0c, 0x00 }, // '('
+    { 0x03, 0x06, 0x0c, 0x0c, 0x0c, 0x06, 0x03, 0x00 }, // ')'
+    { 0x77, 0x3e, 0x7f, 0x3e, 0x77, 0x00, 0x00, 0x00 }, // '*'
+    { 0x0c, 0x0c, 0x3f, 0x0c, 0x0c, 0x00, 0x00, 0x00 }, // '+'
+    { 0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ','
+    { 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '-'
+    { 0x07, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '.'
+    { 0x60, 0x30, 0x18, 0x0c, 0x06, 0x03, 0x01, 0x00 }, // '/'
+    { 0x3e, 0x63, 0x73, 0x7b, 0x6f, 0x67, 0x3e, 0x00 }, // '0'
+    { 0x0c, 0x0f, 0x0c, 0x0c, 0x0c, 0x0c, 0x3f, 0x00 }, // '1'
+    { 0x3e, 0x63, 0x30, 0x18, 0x0c, 0x66, 0x7f, 0x00 }, // '2'
+    { 0x3e, 0x63, 0x60, 0x3c, 0x60, 0x63, 0x3e, 0x00 }, // '3'
+    { 0x30, 0x38, 0x3c, 0x36, 0x7f, 0x30, 0x30, 0x00 }, // '4'
+    { 0x7f, 0x03, 0x3f, 0x60, 0x60, 0x63, 0x3e, 0x00 }, // '5'
+    { 0x3e, 0x63, 0x03, 0x3f, 0x63, 0x63, 0x3e, 0x00 }, // '6'
+    { 0x7f, 0x63, 0x60, 0x30, 0x18, 0x18, 0x18, 0x00 }, // '7'
+    { 0x3e, 0x63, 0x63, 0x3e, 0x63, 0x63, 0x3e, 0x00 }, // '8'
+    { 0x3e, 0x63, 0x63, 0x7e, 0x60, 0x63, 0x3e, 0x00 }, // '9'
+    { 0x07, 0x07, 0x00, 0x00, 0x07, 0x07, 0x00, 0x00 }, // ':'
+    { 0x06, 0x06, 0x00, 0x00, 0x06, 0x06, 0x03, 0x00 }, // ';'
+    { 0x18, 0x0c, 0x06, 0x03, 0x06, 0x0c, 0x18, 0x00 }, // '<'
+    { 0x7f, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00 }, // '='
+    { 0x03, 0x06, 0x0c, 0x18, 0x0c, 0x06, 0x03, 0x00 }, // '>'
+    { 0x3e, 0x63, 0x60, 0x30, 0x18, 0x00, 0x18, 0x00 }, // '?'
+    { 0x3e, 0x63, 0x63, 0x7b, 0x3b, 0x03, 0x7e, 0x00 }, // '@'
+    { 0x1c, 0x36, 0x63, 0x63, 0x7f, 0x63, 0x63, 0x00 }, // 'A'
+    { 0x3f, 0x66, 0x66, 0x3e, 0x66, 0x66, 0x3f, 0x00 }, // 'B'
+    { 0x3c, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3c, 0x00 }, // 'C'
+    { 0x1f, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1f, 0x00 }, // 'D'
+    { 0x7f, 0x43, 0x03, 0x1f, 0x03, 0x43, 0x7f, 0x00 }, // 'E'
+    { 0x7f, 0x46, 0x06, 0x3e, 0x06, 0x06, 0x0f, 0x00 }, // 'F'
+    { 0x3e, 0x63, 0x03, 0x03, 0x7b, 0x63, 0x3e, 0x00 }, // 'G'
+    { 0x63, 0x63, 0x63, 0x7f, 0x63, 0x63, 0x63, 0x00 }, // 'H'
+    { 0x0f, 0x06, 0x06, 0x06, 0x06, 0x06, 0x0f, 0x00 }, // 'I'
+    { 0x3c, 0x18, 0x18, 0x18, 0x1b, 0x1b, 0x0e, 0x00 }, // 'J'
+    { 0x63, 0x33, 0x1b, 0x0f, 0x1b, 0x33, 0x63, 0x00 }, // 'K'
+    { 0x0f, 0x06, 0x06, 0x06, 0x06, 0x46, 0x7f, 0x00 }, // 'L'
+    { 0x63, 0x77, 0x7f, 0x6b, 0x6b, 0x63, 0x63, 0x00 }, // 'M'
+    { 0x63, 0x67, 0x67, 0x6f, 0x7b, 0x73, 0x63, 0x00 }, // 'N'
+    { 0x3e, 0x63, 0x63, 0x63, 0x63, 0x63, 0x3e, 0x00 }, // 'O'
+    { 0x3f, 0x66, 0x66, 0x3e, 0x06, 0x06, 0x0f, 0x00 }, // 'P'
+    { 0x3e, 0x63, 0x63, 0x63, 0x63, 0x6b, 0x3e, 0x60 }, // 'Q'
+    { 0x3f, 0x63, 0x63, 0x3f, 0x1b, 0x33, 0x63, 0x00 }, // 'R'
+    { 0x3e, 0x63, 0x03, 0x3e, 0x60, 0x63, 0x3e, 0x00 }, // 'S'
+    { 0x3f, 0x2d, 0x0c, 0x0c, 0x0c, 0x0c, 0x1e, 0x00 }, // 'T'
+    { 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x3e, 0x00 }, // 'U'
+    { 0x63, 0x63, 0x63, 0x63, 0x36, 0x1c, 0x08, 0x00 }, // 'V'
+    { 0x63, 0x63, 0x6b, 0x6b, 0x7f, 0x77, 0x63, 0x00 }, // 'W'
+    { 0x63, 0x36, 0x1c, 0x1c, 0x1c, 0x36, 0x63, 0x00 }, // 'X'
+    { 0x33, 0x33, 0x33, 0x1e, 0x0c, 0x0c, 0x1e, 0x00 }, // 'Y'
+    { 0x7f, 0x61, 0x30, 0x18, 0x0c, 0x46, 0x7f, 0x00 }, // 'Z'
+    { 0x1f, 0x03, 0x03, 0x03, 0x03, 0x03, 0x1f, 0x00 }, // '['
+    { 0x03, 0x06, 0x0c, 0x18, 0x30, 0x60, 0x40, 0x00 }, // backslash
+    { 0x1f, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1f, 0x00 }, // ']'
+    { 0x08, 0x1c, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00 }, // '^'
+    { 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '_'
+    { 0x03, 0x03, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '`'
+    { 0x1e, 0x30, 0x3e, 0x33, 0x7e, 0x00, 0x00, 0x00 }, // 'a'
+    { 0x07, 0x06, 0x3e, 0x66, 0x66, 0x66, 0x3f, 0x00 }, // 'b'
+    { 0x3e, 0x63, 0x03, 0x63, 0x3e, 0x00, 0x00, 0x00 }, // 'c'
+    { 0x38, 0x30, 0x3e, 0x33, 0x33, 0x33, 0x7e, 0x00 }, // 'd'
+    { 0x3e, 0x63, 0x7f, 0x03, 0x3e, 0x00, 0x00, 0x00 }, // 'e'
+    { 0x38, 0x6c, 0x0c, 0x3f, 0x0c, 0x0c, 0x1e, 0x00 }, // 'f'
+    { 0x6e, 0x73, 0x63, 0x7e, 0x60, 0x3e, 0x00, 0x00 }, // 'g'
+    { 0x07, 0x06, 0x3e, 0x66, 0x66, 0x66, 0x67, 0x00 }, // 'h'
+    { 0x06, 0x00, 0x07, 0x06, 0x06, 0x06, 0x0f, 0x00 }, // 'i'
+    { 0x30, 0x00, 0x38, 0x30, 0x30, 0x30, 0x33, 0x1e }, // 'j'
+    { 0x07, 0x06, 0x66, 0x36, 0x1e, 0x36, 0x67, 0x00 }, // 'k'
+    { 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x07, 0x00 }, // 'l'
+    { 0x36, 0x7f, 0x6b, 0x6b, 0x63, 0x00, 0x00, 0x00 }, // 'm'
+    { 0x3b, 0x66, 0x66, 0x66, 0x66, 0x00, 0x00, 0x00 }, // 'n'
+    { 0x3e, 0x63, 0x63, 0x63, 0x3e, 0x00, 0x00, 0x00 }, // 'o'
+    { 0x3b, 0x66, 0x66, 0x3e, 0x06, 0x0f, 0x00, 0x00 }, // 'p'
+    { 0x6e, 0x33, 0x33, 0x3e, 0x30, 0x78, 0x00, 0x00 }, // 'q'
+    { 0x3b, 0x66, 0x06, 0x06, 0x0f, 0x00, 0x00, 0x00 }, // 'r'
+    { 0x3e, 0x03, 0x3e, 0x60, 0x3e, 0x00, 0x00, 0x00 }, // 's'
+    { 0x0c, 0x0c, 0x3f, 0x0c, 0x0c, 0x6c, 0x38, 0x00 }, // 't'
+    { 0x33, 0x33, 0x33, 0x33, 0x6e, 0x00, 0x00, 0x00 }, // 'u'
+    { 0x63, 0x63, 0x36, 0x1c, 0x08, 0x00, 0x00, 0x00 }, // 'v'
+    { 0x63, 0x63, 0x6b, 0x7f, 0x36, 0x00, 0x00, 0x00 }, // 'w'
+    { 0x63, 0x36, 0x1c, 0x36, 0x63, 0x00, 0x00, 0x00 }, // 'x'
+    { 0x63, 0x63, 0x73, 0x6e, 0x60, 0x3e, 0x00, 0x00 }, // 'y'
+    { 0x3f, 0x19, 0x0c, 0x26, 0x3f, 0x00, 0x00, 0x00 }, // 'z'
+    { 0x38, 0x0c, 0x0c, 0x07, 0x0c, 0x0c, 0x38, 0x00 }, // '{'
+    { 0x03, 0x03, 0x03, 0x00, 0x03, 0x03, 0x03, 0x00 }, // '|'
+    { 0x07, 0x0c, 0x0c, 0x38, 0x0c, 0x0c, 0x07, 0x00 }, // '}'
+    { 0x6e, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '~'
+};
+
+#endif // __ATI8X8_STRIPS_H__
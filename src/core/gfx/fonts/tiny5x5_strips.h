@@ -0,0 +1,105 @@
+#ifndef __TINY5X5_STRIPS_H__
+#define __TINY5X5_STRIPS_H__
+
+#include <stdint.h>
+
+// Glyph bitmaps of tiny5x5 as row masks (bit n = column n), one row of 8 bytes per glyph
+static const uint8_t tiny5x5_strips[][8] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+    { 0x01, 0x01, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00 }, // '!'
+    { 0x05, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '"'
+    { 0x0a, 0x1f, 0x0a, 0x1f, 0x0a, 0x00, 0x00, 0x00 }, // '#'
+    { 0x1e, 0x05, 0x0e, 0x14, 0x0f, 0x00, 0x00, 0x00 }, // '$'
+    { 0x11, 0x08, 0x04, 0x02, 0x11, 0x00, 0x00, 0x00 }, // '%'
+    { 0x02, 0x05, 0x02, 0x05, 0x0a, 0x00, 0x00, 0x00 }, // '&'
+    { 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '''
+    { 0x02, 0x01, 0x01, 0x01, 0x02, 0x00, 0x00, 0x00 }, // '('
+    { 0x01, 0x02, 0x02, 0x02, 0x01, 0x00, 0x00, 0x00 }, // ')'
+    { 0x05, 0x02, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '*'
+    { 0x02, 0x07, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '+'
+    { 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ','
+    { 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '-'
+    { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '.'
+    { 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00, 0x00 }, // '/'
+    { 0x0e, 0x11, 0x11, 0x11, 0x0e, 0x00, 0x00, 0x00 }, // '0'
+    { 0x02, 0x03, 0x02, 0x02, 0x02, 0x00, 0x00, 0x00 }, // '1'
+    { 0x06, 0x09, 0x04, 0x02, 0x0f, 0x00, 0x00, 0x00 }, // '2'
+    { 0x07, 0x08, 0x07, 0x08, 0x07, 0x00, 0x00, 0x00 }, // '3'
+    { 0x04, 0x06, 0x05, 0x0f, 0x04, 0x00, 0x00, 0x00 }, // '4'
+    { 0x0f, 0x01, 0x07, 0x08, 0x07, 0x00, 0x00, 0x00 }, // '5'
+    { 0x06, 0x01, 0x07, 0x09, 0x06, 0x00, 0x00, 0x00 }, // '6'
+    { 0x07, 0x04, 0x02, 0x02, 0x02, 0x00, 0x00, 0x00 }, // '7'
+    { 0x0e, 0x11, 0x0e, 0x11, 0x0e, 0x00, 0x00, 0x00 }, // '8'
+    { 0x0e, 0x11, 0x1e, 0x10, 0x0e, 0x00, 0x00, 0x00 }, // '9'
+    { 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ':'
+    { 0x01, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00 }, // ';'
+    { 0x02, 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '<'
+    { 0x07, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '='
+    { 0x01, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '>'
+    { 0x01, 0x02, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00 }, // '?'
+    { 0x1c, 0x22, 0x49, 0x55, 0x59, 0x22, 0x0c, 0x00 }, // '@'
+    { 0x0e, 0x11, 0x1f, 0x11, 0x11, 0x00, 0x00, 0x00 }, // 'A'
+    { 0x0f, 0x11, 0x0f, 0x11, 0x0f, 0x00, 0x00, 0x00 }, // 'B'
+    { 0x1e, 0x01, 0x01, 0x01, 0x1e, 0x00, 0x00, 0x00 }, // 'C'
+    { 0x0f, 0x11, 0x11, 0x11, 0x0f, 0x00, 0x00, 0x00 }, // 'D'
+    { 0x1f, 0x01, 0x07, 0x01, 0x1f, 0x00, 0x00, 0x00 }, // 'E'
+    { 0x1f, 0x01, 0x07, 0x01, 0x01, 0x00, 0x00, 0x00 }, // 'F'
+    { 0x1e, 0x01, 0x1d, 0x11, 0x0e, 0x00, 0x00, 0x00 }, // 'G'
+    { 0x11, 0x11, 0x1f, 0x11, 0x11, 0x00, 0x00, 0x00 }, // 'H'
+    { 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00 }, // 'I'
+    { 0x10, 0x10, 0x10, 0x11, 0x0e, 0x00, 0x00, 0x00 }, // 'J'
+    { 0x09, 0x05, 0x03, 0x05, 0x09, 0x00, 0x00, 0x00 }, // 'K'
+    { 0x01, 0x01, 0x01, 0x01, 0x1f, 0x00, 0x00, 0x00 }, // 'L'
+    { 0x11, 0x1b, 0x15, 0x11, 0x11, 0x00, 0x00, 0x00 }, // 'M'
+    { 0x11, 0x13, 0x15, 0x19, 0x11, 0x00, 0x00, 0x00 }, // 'N'
+    { 0x0e, 0x11, 0x11, 0x11, 0x0e, 0x00, 0x00, 0x00 }, // 'O'
+    { 0x0f, 0x11, 0x0f, 0x01, 0x01, 0x00, 0x00, 0x00 }, // 'P'
+    { 0x0e, 0x11, 0x11, 0x19, 0x1e, 0x00, 0x00, 0x00 }, // 'Q'
+    { 0x0f, 0x11, 0x0f, 0x09, 0x11, 0x00, 0x00, 0x00 }, // 'R'
+    { 0x1e, 0x01, 0x0e, 0x10, 0x0f, 0x00, 0x00, 0x00 }, // 'S'
+    { 0x1f, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00 }, // 'T'
+    { 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00, 0x00, 0x00 }, // 'U'
+    { 0x11, 0x11, 0x0a, 0x0a, 0x04, 0x00, 0x00, 0x00 }, // 'V'
+    { 0x15, 0x15, 0x15, 0x0a, 0x0a, 0x00, 0x00, 0x00 }, // 'W'
+    { 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x00, 0x00, 0x00 }, // 'X'
+    { 0x11, 0x0a, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00 }, // 'Y'
+    { 0x1f, 0x08, 0x04, 0x02, 0x1f, 0x00, 0x00, 0x00 }, // 'Z'
+    { 0x03, 0x01, 0x01, 0x01, 0x03, 0x00, 0x00, 0x00 }, // '['
+    { 0x01, 0x02, 0x04, 0x08, 0x10, 0x00, 0x00, 0x00 }, // backslash
+    { 0x03, 0x02, 0x02, 0x02, 0x03, 0x00, 0x00, 0x00 }, // ']'
+    { 0x02, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '^'
+    { 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '_'
+    { 0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '`'
+    { 0x0e, 0x11, 0x1f, 0x11, 0x11, 0x00, 0x00, 0x00 }, // 'a'
+    { 0x0f, 0x11, 0x0f, 0x11, 0x0f, 0x00, 0x00, 0x00 }, // 'b'
+    { 0x1e, 0x01, 0x01, 0x01, 0x1e, 0x00, 0x00, 0x00 }, // 'c'
+    { 0x0f, 0x11, 0x11, 0x11, 0x0f, 0x00, 0x00, 0x00 }, // 'd'
+    { 0x1f, 0x01, 0x07, 0x01, 0x1f, 0x00, 0x00, 0x00 }, // 'e'
+    { 0x1f, 0x01, 0x07, 0x01, 0x01, 0x00, 0x00, 0x00 }, // 'f'
+    { 0x1e, 0x01, 0x1d, 0x11, 0x0e, 0x00, 0x00, 0x00 }, // 'g'
+    { 0x11, 0x11, 0x1f, 0x11, 0x11, 0x00, 0x00, 0x00 }, // 'h'
+    { 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00 }, // 'i'
+    { 0x10, 0x10, 0x10, 0x11, 0x0e, 0x00, 0x00, 0x00 }, // 'j'
+    { 0x09, 0x05, 0x03, 0x05, 0x09, 0x00, 0x00, 0x00 }, // 'k'
+    { 0x01, 0x01, 0x01, 0x01, 0x1f, 0x00, 0x00, 0x00 }, // 'l'
+    { 0x11, 0x1b, 0x15, 0x11, 0x11, 0x00, 0x00, 0x00 }, // 'm'
+    { 0x11, 0x13, 0x15, 0x19, 0x11, 0x00, 0x00, 0x00 }, // 'n'
+    { 0x0e, 0x11, 0x11, 0x11, 0x0e, 0x00, 0x00, 0x00 }, // 'o'
+    { 0x0f, 0x11, 0x0f, 0x01, 0x01, 0x00, 0x00, 0x00 }, // 'p'
+    { 0x0e, 0x11, 0x11, 0x19, 0x1e, 0x00, 0x00, 0x00 }, // 'q'
+    { 0x0f, 0x11, 0x0f, 0x09, 0x11, 0x00, 0x00, 0x00 }, // 'r'
+    { 0x1e, 0x01, 0x0e, 0x10, 0x0f, 0x00, 0x00, 0x00 }, // 's'
+    { 0x1f, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00 }, // 't'
+    { 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00, 0x00, 0x00 }, // 'u'
+    { 0x11, 0x11, 0x0a, 0x0a, 0x04, 0x00, 0x00, 0x00 }, // 'v'
+    { 0x15, 0x15, 0x15, 0x0a, 0x0a, 0x00, 0x00, 0x00 }, // 'w'
+    { 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x00, 0x00, 0x00 }, // 'x'
+    { 0x11, 0x0a, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00 }, // 'y'
+    { 0x1f, 0x08, 0x04, 0x02, 0x1f, 0x00, 0x00, 0x00 }, // 'z'
+    { 0x02, 0x02, 0x01, 0x02, 0x02, 0x00, 0x00, 0x00 }, // '{'
+    { 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00 }, // '|'
+    { 0x01, 0x01, 0x02, 0x01, 0x01, 0x00, 0x00, 0x00 }, // '}'
+    { 0x10, 0x0e, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '~'
+};
+
+#endif // __TINY5X5_STRIPS_H__
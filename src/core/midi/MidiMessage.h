@@ -264,7 +264,7 @@ public:
         _raw[0] = length > 0 ? raw[0] : 0;
         _raw[1] = length > 1 ? raw[1] : 0;
         _raw[2] = length > 2 ? raw[2] : 0;
-        _length = std::min(size_t(2), length);
+        _length = std::min(size_t(3), length);
     }
 
     // Factory
@@ -298,6 +298,22 @@ public:
         return MidiMessage(PitchBend | channel, pitchBend & 0x7f, (pitchBend >> 7) & 0x7f);
     }
 
+    // Splits a complete sysex message into chunks of up to 3 bytes as carried
+    // by usb midi event packets. Only the first chunk starts with a status byte.
+    template<typename F>
+    static void splitSysEx(const uint8_t *data, size_t length, F f) {
+        while (length > 0) {
+            size_t chunk = std::min(size_t(3), length);
+            f(MidiMessage(data, chunk));
+            data += chunk;
+            length -= chunk;
+        }
+    }
+
+    static size_t sysExChunks(size_t length) {
+        return (length + 2) / 3;
+    }
+
     static void dump(const MidiMessage &msg);
 
 private:
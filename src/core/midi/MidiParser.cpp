@@ -15,10 +15,19 @@ bool MidiParser::feed(uint8_t data) {
             _message = MidiMessage(data);
             return true;
         } else if (MidiMessage::isSystemMessage(data)) {
+            if (_recvSystemExclusive && data != MidiMessage::EndOfExclusive) {
+                emitSysEx(SysExAborted);
+                _recvSystemExclusive = false;
+            }
             switch (MidiMessage::systemMessage(data)) {
             case MidiMessage::SystemExclusive:
                 // start system exclusive receive
                 _recvSystemExclusive = true;
+                _sysExLength = 0;
+                _sysExOffset = 0;
+                // cancel running status
+                _status = 0;
+                _dataLength = 0;
                 break;
             case MidiMessage::TimeCode:
             case MidiMessage::SongPosition:
@@ -37,11 +46,16 @@ bool MidiParser::feed(uint8_t data) {
                 return true;
             case MidiMessage::EndOfExclusive:
                 // end system exclusive receive
+                if (_recvSystemExclusive) {
+                    emitSysEx(SysExEnd);
+                }
                 _recvSystemExclusive = false;
-                // TODO emit message
                 break;
             }
         } else if (MidiMessage::isChannelMessage(data)) {
+            if (_recvSystemExclusive) {
+                emitSysEx(SysExAborted);
+            }
             _recvSystemExclusive = false;
             // update running status
             _status = data;
@@ -54,16 +68,28 @@ bool MidiParser::feed(uint8_t data) {
     } else {
         // DBG("data %d data length %d", _dataIndex, _dataLength);
         if (_recvSystemExclusive) {
-            // TODO add to buffer
-        } else if (_dataLength > 0) {
-            _data[_dataIndex++] = data;
-            if (_dataIndex == _dataLength) {
-                _dataIndex = 0;
-                // emit message
-                _message = (_dataLength == 1) ? MidiMessage(_status, _data[0]) : MidiMessage(_status, _data[0], _data[1]);
-                return true;
+            _sysExData[_sysExLength++] = data;
+            if (_sysExLength == SysExChunkSize) {
+                emitSysEx(SysExContinue);
             }
+        } else if (_dataLength > 0) {
+            return feedData(data);
         }
     }
     return false;
 }
+
+void MidiParser::abortSysEx() {
+    if (_recvSystemExclusive) {
+        emitSysEx(SysExAborted);
+        _recvSystemExclusive = false;
+    }
+}
+
+void MidiParser::emitSysEx(SysExStatus status) {
+    if (_sysExHandler) {
+        _sysExHandler(_sysExData, _sysExLength, _sysExOffset, status);
+    }
+    _sysExOffset += _sysExLength;
+    _sysExLength = 0;
+}
@@ -2,20 +2,75 @@
 
 #include "MidiMessage.h"
 
+#include <functional>
+
+#include <cstddef>
 #include <cstdint>
 
 class MidiParser {
 public:
+    static constexpr size_t SysExChunkSize = 16;
+
+    enum SysExStatus {
+        SysExContinue,  // more chunks follow
+        SysExEnd,       // last chunk, message was terminated by end of exclusive
+        SysExAborted,   // last chunk, message was interrupted by another status byte
+    };
+
+    // Receives the payload of system exclusive messages (without the 0xf0 and 0xf7 framing bytes)
+    // in chunks of up to SysExChunkSize bytes. The data points into the parser buffer and is only
+    // valid during the call. offset is the position of the chunk within the payload, the last
+    // chunk may be empty.
+    typedef std::function<void(const uint8_t *data, size_t length, size_t offset, SysExStatus status)> SysExHandler;
+
     MidiParser() {
     }
 
     bool feed(uint8_t data);
 
+    // feeds a block of bytes and calls sink(const MidiMessage &) for each complete message,
+    // returns the number of messages
+    template<typename Sink>
+    size_t feed(const uint8_t *data, size_t length, Sink &&sink) {
+        size_t count = 0;
+        for (size_t i = 0; i < length; ++i) {
+            uint8_t byte = data[i];
+            // data bytes of channel messages take the short path
+            bool complete = (!(byte & 0x80) && _dataLength > 0 && !_recvSystemExclusive) ? feedData(byte) : feed(byte);
+            if (complete) {
+                sink(_message);
+                ++count;
+            }
+        }
+        return count;
+    }
+
     const MidiMessage &message() const {
         return _message;
     }
 
+    void setSysExHandler(SysExHandler handler) {
+        _sysExHandler = handler;
+    }
+
+    // aborts the system exclusive message being received,
+    // following data bytes are ignored until the next status byte
+    void abortSysEx();
+
 private:
+    bool feedData(uint8_t data) {
+        _data[_dataIndex++] = data;
+        if (_dataIndex == _dataLength) {
+            _dataIndex = 0;
+            // emit message
+            _message = (_dataLength == 1) ? MidiMessage(_status, _data[0]) : MidiMessage(_status, _data[0], _data[1]);
+            return true;
+        }
+        return false;
+    }
+
+    void emitSysEx(SysExStatus status);
+
     uint8_t _status = 0;
     uint8_t _data[2] = { 0, 0 };
     uint8_t _dataIndex = 0;
@@ -23,4 +78,9 @@ private:
     bool _recvSystemExclusive = false;
 
     MidiMessage _message;
+
+    SysExHandler _sysExHandler;
+    uint8_t _sysExData[SysExChunkSize];
+    uint8_t _sysExLength = 0;
+    size_t _sysExOffset = 0;
 };
@@ -0,0 +1,74 @@
+#include "MidiTxQueue.h"
+
+// bank select, data entry and (N)RPN controllers only make sense in the order they were sent
+static bool isSequencedController(uint8_t controlNumber) {
+    return controlNumber == 0 || controlNumber == 32 ||
+           controlNumber == 6 || controlNumber == 38 ||
+           (controlNumber >= 96 && controlNumber <= 101);
+}
+
+bool MidiTxQueue::write(const MidiMessage &message) {
+    // a control change replaces a queued one of the same controller
+    if (message.isControlChange() && !isSequencedController(message.controlNumber())) {
+        for (size_t i = 0; i < _messageQueue.readable(); ++i) {
+            auto &queued = _messageQueue.peek(i);
+            if (queued.isControlChange() && queued.channel() == message.channel() && queued.controlNumber() == message.controlNumber()) {
+                queued = message;
+                _bytesSaved += message.length();
+                return true;
+            }
+        }
+    }
+
+    if (_messageQueue.full()) {
+        return false;
+    }
+    _messageQueue.write(message);
+
+    uint32_t entries = _messageQueue.readable();
+    if (entries > _highWatermark) {
+        _highWatermark = entries;
+    }
+    return true;
+}
+
+bool MidiTxQueue::writeRealTime(uint8_t data) {
+    if (_realTimeQueue.full()) {
+        return false;
+    }
+    _realTimeQueue.write(data);
+    return true;
+}
+
+bool MidiTxQueue::read(uint8_t &data) {
+    if (!_realTimeQueue.empty()) {
+        data = _realTimeQueue.read();
+        return true;
+    }
+
+    if (_index >= _message.length()) {
+        if (_messageQueue.empty()) {
+            // start with a status byte once the output has been idle
+            _runningStatus = 0;
+            return false;
+        }
+        _message = _messageQueue.read();
+        _index = 0;
+
+        uint8_t status = _message.status();
+        if (MidiMessage::isChannelMessage(status)) {
+            if (status == _runningStatus) {
+                // skip the status byte
+                _index = 1;
+                ++_bytesSaved;
+            }
+            _runningStatus = status;
+        } else if (MidiMessage::isSystemMessage(status)) {
+            // system common messages cancel running status
+            _runningStatus = 0;
+        }
+    }
+
+    data = _message.raw()[_index++];
+    return true;
+}
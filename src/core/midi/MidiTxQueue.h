@@ -0,0 +1,46 @@
+#pragma once
+
+#include "MidiMessage.h"
+
+#include "core/utils/RingBuffer.h"
+
+#include <cstdint>
+
+// Transmit queue for byte oriented midi outputs (DIN).
+// Real-time bytes (clock, start, stop ...) are kept in a separate lane and
+// are sent ahead of queued messages, also between the bytes of a message
+// that is currently being sent, as allowed by the midi specification.
+// Channel messages are sent with running status while the queue is busy and
+// control changes that are superseded before being sent are dropped, except
+// for bank select, data entry and (N)RPN controllers.
+class MidiTxQueue {
+public:
+    bool empty() const {
+        return _realTimeQueue.empty() && _messageQueue.empty() && _index >= _message.length();
+    }
+
+    // queues a message, returns false if the queue is full
+    bool write(const MidiMessage &message);
+
+    // queues a real-time byte, returns false if the queue is full
+    bool writeRealTime(uint8_t data);
+
+    // returns the next byte to send, returns false if the queue is empty
+    bool read(uint8_t &data);
+
+    // maximum number of queued messages
+    uint32_t highWatermark() const { return _highWatermark; }
+
+    // bytes saved by running status and control change coalescing
+    uint32_t bytesSaved() const { return _bytesSaved; }
+
+private:
+    RingBuffer<uint8_t, 16> _realTimeQueue;
+    RingBuffer<MidiMessage, 32> _messageQueue;
+    // message currently being sent
+    MidiMessage _message;
+    uint8_t _index = 0;
+    uint8_t _runningStatus = 0;
+    uint32_t _highWatermark = 0;
+    uint32_t _bytesSaved = 0;
+};
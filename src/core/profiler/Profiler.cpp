@@ -2,13 +2,31 @@
 
 #include "core/Debug.h"
 
+#include "os/os.h"
+
+#include <algorithm>
+
+#include <cstdio>
+
 #if CONFIG_ENABLE_PROFILER
+
+bool Profiler::_enabled = false;
 int Profiler::_numIntervals;
 int Profiler::_numCounters;
 Profiler::Interval *Profiler::_intervals[Profiler::MaxIntervals];
 Profiler::Counter *Profiler::_counters[Profiler::MaxCounters];
+CCMRAM_BSS Profiler::Event Profiler::_events[Profiler::EventCount];
+uint32_t Profiler::_eventsWritten;
+
+static_assert((CONFIG_PROFILER_EVENT_COUNT & (CONFIG_PROFILER_EVENT_COUNT - 1)) == 0, "event count must be a power of two");
+
+static const int MaxTasks = 16;
+static int numTasks;
+static os::TaskHandle taskHandles[MaxTasks];
+static const char *taskNames[MaxTasks];
 
 void Profiler::init() {
+    _enabled = false;
 }
 
 void Profiler::dump() {
@@ -17,22 +35,140 @@ void Profiler::dump() {
     if (_numIntervals > 0) {
         DBG("Intervals:");
         for (int i = 0; i < _numIntervals; ++i) {
-            const auto &interval = *_intervals[i];
-            DBG("  %s: %lu us", interval.desc, interval.avg);
+            auto &interval = *_intervals[i];
+            if (interval.count > 0) {
+                DBG("  %s: avg %lu us, min %lu us, max %lu us (%lu calls)",
+                    interval.desc,
+                    (unsigned long)(interval.total / interval.count),
+                    (unsigned long)(interval.min),
+                    (unsigned long)(interval.max),
+                    (unsigned long)(interval.count)
+                );
+            } else {
+                DBG("  %s: -", interval.desc);
+            }
+            interval.count = 0;
+            interval.total = 0;
+            interval.min = 0;
+            interval.max = 0;
         }
     }
     if (_numCounters > 0) {
         DBG("Counters:");
         for (int i = 0; i < _numCounters; ++i) {
             const auto &counter = *_counters[i];
-            DBG("  %s: %lu", counter.desc, counter.count);
+            DBG("  %s: %lu", counter.desc, (unsigned long)(counter.count));
         }
     }
     DBG("---------------------------------------------");
 }
 
+void Profiler::dumpEvents() {
+    uint32_t count = std::min(_eventsWritten, uint32_t(EventCount));
+    DBG("Profiler Events:");
+    DBG("---------------------------------------------");
+    DBG("time (us)  task         event");
+    for (uint32_t i = _eventsWritten - count; i != _eventsWritten; ++i) {
+        const auto &event = _events[i % EventCount];
+        const char *task = taskNames[event.task];
+        switch (event.type) {
+        case EventType::Begin:
+            DBG("%10lu %-12s > %s (%ld)", (unsigned long)(event.time), task, _intervals[event.id]->desc, (long)(event.value));
+            break;
+        case EventType::End:
+            DBG("%10lu %-12s < %s (%ld)", (unsigned long)(event.time), task, _intervals[event.id]->desc, (long)(event.value));
+            break;
+        case EventType::Counter:
+            DBG("%10lu %-12s = %s %ld", (unsigned long)(event.time), task, _counters[event.id]->desc, (long)(event.value));
+            break;
+        }
+    }
+    DBG("---------------------------------------------");
+}
+
+void Profiler::clear() {
+    _eventsWritten = 0;
+}
+
+void Profiler::writeChromeTrace(std::function<void(const char *)> write) {
+    char buffer[256];
+    bool first = true;
+
+    auto writeEvent = [&] () {
+        write(first ? "\n" : ",\n");
+        write(buffer);
+        first = false;
+    };
+
+    write("{\"traceEvents\":[");
+
+    for (int task = 0; task < numTasks; ++task) {
+        std::snprintf(buffer, sizeof(buffer),
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+            task, taskNames[task]
+        );
+        writeEvent();
+    }
+
+    uint32_t count = std::min(_eventsWritten, uint32_t(EventCount));
+    uint32_t startTime = count > 0 ? _events[(_eventsWritten - count) % EventCount].time : 0;
+    int depth[MaxTasks] = { 0 };
+
+    for (uint32_t i = _eventsWritten - count; i != _eventsWritten; ++i) {
+        const auto &event = _events[i % EventCount];
+        unsigned long time = event.time - startTime;
+        switch (event.type) {
+        case EventType::Begin:
+            ++depth[event.task];
+            std::snprintf(buffer, sizeof(buffer),
+                "{\"name\":\"%s\",\"ph\":\"B\",\"ts\":%lu,\"pid\":1,\"tid\":%d,\"args\":{\"arg\":%ld}}",
+                _intervals[event.id]->desc, time, event.task, (long)(event.value)
+            );
+            break;
+        case EventType::End:
+            // skip end events whose begin event has been overwritten
+            if (depth[event.task] == 0) {
+                continue;
+            }
+            --depth[event.task];
+            std::snprintf(buffer, sizeof(buffer),
+                "{\"name\":\"%s\",\"ph\":\"E\",\"ts\":%lu,\"pid\":1,\"tid\":%d}",
+                _intervals[event.id]->desc, time, event.task
+            );
+            break;
+        case EventType::Counter:
+            std::snprintf(buffer, sizeof(buffer),
+                "{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%lu,\"pid\":1,\"args\":{\"value\":%ld}}",
+                _counters[event.id]->desc, time, (long)(event.value)
+            );
+            break;
+        }
+        writeEvent();
+    }
+
+    write("\n]}\n");
+}
+
+uint32_t Profiler::Interval::enter(int arg) {
+    uint32_t time = HighResolutionTimer::us();
+    record(EventType::Begin, id, arg, time);
+    return time;
+}
+
+void Profiler::Interval::leave(uint32_t start, int arg) {
+    uint32_t time = HighResolutionTimer::us();
+    record(EventType::End, id, arg, time);
+
+    uint32_t duration = time - start;
+    min = count == 0 ? duration : std::min(min, duration);
+    max = count == 0 ? duration : std::max(max, duration);
+    total += duration;
+    ++count;
+}
+
 void Profiler::registerInterval(Interval *interval) {
     if (_numIntervals < MaxIntervals) {
+        interval->id = _numIntervals;
         _intervals[_numIntervals++] = interval;
     } else {
         DBG("Profiler: Too many profiler intervals!");
@@ -41,10 +177,37 @@ void Profiler::registerInterval(Interval *interval) {
 
 void Profiler::registerCounter(Counter *counter) {
     if (_numCounters < MaxCounters) {
+        counter->id = _numCounters;
         _counters[_numCounters++] = counter;
     } else {
         DBG("Profiler: Too many profiler counters");
     }
 }
 
+void Profiler::record(EventType type, uint8_t id, int32_t value, uint32_t time) {
+    os::InterruptLock lock;
+
+    auto &event = _events[_eventsWritten++ % EventCount];
+    event.time = time;
+    event.value = value;
+    event.type = type;
+    event.id = id;
+    event.task = taskIndex();
+}
+
+uint8_t Profiler::taskIndex() {
+    os::TaskHandle handle = os::this_task::handle();
+    for (int i = 0; i < numTasks; ++i) {
+        if (taskHandles[i] == handle) {
+            return i;
+        }
+    }
+    if (numTasks < MaxTasks) {
+        taskHandles[numTasks] = handle;
+        taskNames[numTasks] = os::this_task::name();
+        return numTasks++;
+    }
+    return MaxTasks - 1;
+}
+
 #endif // CONFIG_ENABLE_PROFILER
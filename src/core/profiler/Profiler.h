@@ -4,32 +4,81 @@
 
 #include "drivers/HighResolutionTimer.h"
 
+#include <functional>
+
 #include <cstdint>
 
 #if CONFIG_ENABLE_PROFILER
 
+// Records begin/end events of intervals and counter values into a ring buffer.
+// Besides keeping per interval statistics, the recorded events can be printed to the
+// console or exported as a timeline in the chrome trace event format, which can be
+// viewed with chrome://tracing or ui.perfetto.dev.
 class Profiler {
 public:
+    // recording is disabled until enabled with setEnabled()
     static void init();
+
+    // prints interval statistics and counters and resets the statistics
     static void dump();
+    // prints the recorded events
+    static void dumpEvents();
+
+    static void clear();
+
+    static bool enabled() { return _enabled; }
+    static void setEnabled(bool enabled) { _enabled = enabled; }
+
+    // writes the recorded events in chrome trace event format
+    static void writeChromeTrace(std::function<void(const char *)> write);
 
     struct Interval {
         Interval(const char *desc) : desc(desc) {
             registerInterval(this);
         }
 
-        inline void begin() {
-            start = HighResolutionTimer::us();
+        inline void begin(int arg = 0) {
+            if (_enabled) {
+                start = enter(arg);
+            }
         }
 
-        inline void end() {
-            uint32_t end = HighResolutionTimer::us();
-            avg = end - start;
+        inline void end(int arg = 0) {
+            if (_enabled) {
+                leave(start, arg);
+            }
         }
 
+        uint32_t enter(int arg);
+        void leave(uint32_t start, int arg);
+
         const char *desc;
+        uint8_t id;
         uint32_t start;
-        uint32_t avg;
+        uint32_t count;
+        uint32_t total;
+        uint32_t min;
+        uint32_t max;
+    };
+
+    class IntervalScope {
+    public:
+        IntervalScope(Interval &interval, int arg = 0) :
+            _interval(interval),
+            _arg(arg),
+            _start(_enabled ? interval.enter(arg) : 0)
+        {}
+
+        ~IntervalScope() {
+            if (_enabled) {
+                _interval.leave(_start, _arg);
+            }
+        }
+
+    private:
+        Interval &_interval;
+        int _arg;
+        uint32_t _start;
     };
 
     struct Counter {
@@ -39,35 +88,62 @@ public:
 
         inline void add(int num = 1) {
             count += num;
+            if (_enabled) {
+                record(EventType::Counter, id, count, HighResolutionTimer::us());
+            }
         }
 
         const char *desc;
+        uint8_t id;
         uint32_t count;
     };
 
 private:
     static const int MaxIntervals = 16;
     static const int MaxCounters = 16;
+    static const int EventCount = CONFIG_PROFILER_EVENT_COUNT;
+
+    enum class EventType : uint8_t {
+        Begin,
+        End,
+        Counter,
+    };
+
+    struct Event {
+        uint32_t time;
+        int32_t value;
+        EventType type;
+        uint8_t id;
+        uint8_t task;
+    };
 
     static void registerInterval(Interval *interval);
     static void registerCounter(Counter *counter);
 
+    static void record(EventType type, uint8_t id, int32_t value, uint32_t time);
+    static uint8_t taskIndex();
+
+    static bool _enabled;
     static int _numIntervals;
     static int _numCounters;
     static Interval *_intervals[MaxIntervals];
     static Counter *_counters[MaxCounters];
+    static Event _events[EventCount];
+    static uint32_t _eventsWritten;
 };
 
 # define PROFILER_INTERVAL(_name_, _desc_) \
     static Profiler::Interval _name_##_profiler_interval(_desc_);
-# define PROFILER_INTERVAL_BEGIN(_name_) \
-    _name_##_profiler_interval.begin();
-# define PROFILER_INTERVAL_END(_name_) \
-    _name_##_profiler_interval.end();
+# define PROFILER_INTERVAL_BEGIN(_name_, ...) \
+    _name_##_profiler_interval.begin(__VA_ARGS__);
+# define PROFILER_INTERVAL_END(_name_, ...) \
+    _name_##_profiler_interval.end(__VA_ARGS__);
+# define PROFILER_INTERVAL_SCOPE(_name_, ...) \
+    Profiler::IntervalScope _name_##_profiler_scope(_name_##_profiler_interval, ##__VA_ARGS__);
 
 # define PROFILER_COUNTER(_name_, _desc_) \
     static Profiler::Counter _name_##_profiler_counter(_desc_);
-# define PROFILER_COUNTER_ADD(_num_) \
+# define PROFILER_COUNTER_ADD(_name_, _num_) \
     _name_##_profiler_counter.add(_num_);
 
 #else // CONFIG_ENABLE_PROFILER
@@ -76,13 +152,21 @@ class Profiler {
 public:
     static void init() {}
     static void dump() {}
+    static void dumpEvents() {}
+    static void clear() {}
+
+    static bool enabled() { return false; }
+    static void setEnabled(bool enabled) {}
+
+    static void writeChromeTrace(std::function<void(const char *)> write) {}
 };
 
 # define PROFILER_INTERVAL(_name_, _desc_)
-# define PROFILER_INTERVAL_BEGIN(_name_)
-# define PROFILER_INTERVAL_END(_name_)
+# define PROFILER_INTERVAL_BEGIN(_name_, ...)
+# define PROFILER_INTERVAL_END(_name_, ...)
+# define PROFILER_INTERVAL_SCOPE(_name_, ...)
 
 # define PROFILER_COUNTER(_name_, _desc_)
-# define PROFILER_COUNTER_ADD(_num_)
+# define PROFILER_COUNTER_ADD(_name_, _num_)
 
 #endif // CONFIG_ENABLE_PROFILER
@@ -33,6 +33,11 @@ public:
         }
     }
 
+    // returns the entry at the given offset from the read position
+    inline T &peek(size_t index) {
+        return _buffer[(_read + index) % Size];
+    }
+
     inline T read() {
         size_t read = _read;
         T value = _buffer[read];
@@ -42,7 +47,7 @@ public:
 
     inline void read(T *data, size_t length) {
         while (length--) {
-            read(*data++);
+            *data++ = read();
         }
     }
 
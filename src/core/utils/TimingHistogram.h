@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+
+#include <cstdint>
+#include <cstdlib>
+
+// Fixed bucket histogram of timing deltas in microseconds.
+// Samples are bucketed by their absolute value, while min/max keep the sign
+// to tell early from late events. Recording is cheap enough to be used from
+// interrupt handlers.
+class TimingHistogram {
+public:
+    static constexpr int BucketCount = 8;
+
+    // upper bounds (exclusive) of the buckets, the last bucket is open ended
+    static uint32_t bucketLimit(int index) {
+        static const uint32_t limits[BucketCount - 1] = { 10, 50, 100, 250, 500, 1000, 2000 };
+        return limits[index];
+    }
+
+    static int bucketIndex(int32_t delta) {
+        uint32_t value = std::abs(delta);
+        int index = 0;
+        while (index < BucketCount - 1 && value >= bucketLimit(index)) {
+            ++index;
+        }
+        return index;
+    }
+
+    void reset() {
+        *this = TimingHistogram();
+    }
+
+    void record(int32_t delta) {
+        ++_buckets[bucketIndex(delta)];
+        _min = _count == 0 ? delta : std::min(_min, delta);
+        _max = _count == 0 ? delta : std::max(_max, delta);
+        _total += std::abs(delta);
+        ++_count;
+    }
+
+    uint32_t bucket(int index) const { return _buckets[index]; }
+
+    uint32_t count() const { return _count; }
+    int32_t min() const { return _min; }
+    int32_t max() const { return _max; }
+
+    // average absolute delta
+    uint32_t mean() const { return _count > 0 ? _total / _count : 0; }
+
+    // smallest bucket limit below which the given fraction of samples lies
+    uint32_t percentileLimit(float fraction) const {
+        uint32_t target = _count * fraction;
+        uint32_t sum = 0;
+        for (int i = 0; i < BucketCount - 1; ++i) {
+            sum += _buckets[i];
+            if (sum >= target) {
+                return bucketLimit(i);
+            }
+        }
+        return uint32_t(-1);
+    }
+
+private:
+    uint32_t _buckets[BucketCount] = { 0 };
+    uint32_t _count = 0;
+    uint64_t _total = 0;
+    int32_t _min = 0;
+    int32_t _max = 0;
+};
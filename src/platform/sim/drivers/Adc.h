@@ -13,12 +13,14 @@ class Adc : private sim::TargetInputHandler {
 public:
     static constexpr int Channels = CONFIG_ADC_CHANNELS;
 
-    Adc() {
+    Adc() : Adc(sim::Simulator::current()) {}
+
+    Adc(sim::Simulator &simulator) {
         for (int channel = 0; channel < Channels; ++channel) {
             _channels[channel] = 0x7fff;
         }
 
-        sim::Simulator::instance().registerTargetInputObserver(this);
+        simulator.registerTargetInputObserver(this);
     }
 
     void init() {}
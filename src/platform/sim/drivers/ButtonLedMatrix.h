@@ -33,16 +33,24 @@ public:
     static constexpr int ColsButton = CONFIG_BLM_COLS_BUTTON;
     static constexpr int ColsLed = CONFIG_BLM_COLS_LED;
 
-    ButtonLedMatrix() :
-        _simulator(sim::Simulator::instance())
+    ButtonLedMatrix() : ButtonLedMatrix(sim::Simulator::current()) {}
+
+    ButtonLedMatrix(sim::Simulator &simulator) :
+        _simulator(simulator)
     {
         _simulator.registerTargetInputObserver(this);
+        _ledState.fill(uint8_t(UnknownState));
     }
 
     void init() {}
 
+    // only changed leds are written to the simulator
     void setLed(int index, uint8_t red, uint8_t green) {
-        _simulator.writeLed(index, red > 0, green > 0);
+        uint8_t state = (red > 0 ? 1 : 0) | (green > 0 ? 2 : 0);
+        if (state != _ledState[index]) {
+            _ledState[index] = state;
+            _simulator.writeLed(index, red > 0, green > 0);
+        }
     }
 
     void setLed(int row, int col, uint8_t red, uint8_t green) {
@@ -85,7 +93,11 @@ private:
         }
     }
 
+    // forces the first write of each led
+    static constexpr uint8_t UnknownState = 0xff;
+
     sim::Simulator &_simulator;
+    std::array<uint8_t, Rows * ColsLed> _ledState;
     std::bitset<Rows * ColsButton> _buttonState;
     std::deque<Event> _events;
 };
@@ -2,6 +2,8 @@
 
 #include "sim/Simulator.h"
 
+#include <algorithm>
+
 #include <cstdint>
 
 class ClockTimer {
@@ -10,11 +12,11 @@ public:
         virtual void onClockTimerTick() = 0;
     };
 
-    ClockTimer() :
-        _simulator(sim::Simulator::instance())
-    {
-        _simulator.addUpdateCallback([this] () { update(); });
-    }
+    ClockTimer() : ClockTimer(sim::Simulator::current()) {}
+
+    ClockTimer(sim::Simulator &simulator) :
+        _simulator(simulator)
+    {}
 
     void init() {
     }
@@ -24,45 +26,65 @@ public:
     }
 
     void enable() {
+        disable();
         _enabled = true;
-        _lastTicks = _simulator.ticks();
+        _lastTickUs = _simulator.timeUs();
+        schedule();
     }
 
     void disable() {
         _enabled = false;
+        // invalidate the scheduled tick
+        ++_generation;
     }
 
     uint32_t period() const {
         return _period;
     }
 
+    // like the hardware timer, a new period already applies to the running interval
     void setPeriod(uint32_t us) {
-        _period = us;
-        _periodTicks = us * 0.001;
+        if (us != _period) {
+            _period = us;
+            if (_enabled) {
+                ++_generation;
+                schedule();
+            }
+        }
     }
 
     void setListener(Listener *listener) {
         _listener = listener;
     }
 
+    // current time used to measure timer accuracy (simulated time)
+    uint32_t timeUs() const {
+        return uint32_t(_simulator.timeUs());
+    }
+
 private:
-    void update() {
-        if (!_enabled) {
+    void schedule() {
+        if (_period == 0) {
             return;
         }
-        double ticks = _simulator.ticks();
-        while (ticks - _lastTicks >= _periodTicks) {
-            _lastTicks += _periodTicks;
+        uint32_t generation = _generation;
+        uint64_t timeUs = std::max(_simulator.timeUs(), _lastTickUs + _period);
+        _simulator.scheduleTimer(timeUs, [this, generation, timeUs] () {
+            if (generation != _generation) {
+                return;
+            }
+            _lastTickUs = timeUs;
+            schedule();
             if (_listener) {
                 _listener->onClockTimerTick();
             }
-        }
+        });
     }
 
     sim::Simulator &_simulator;
     uint32_t _period = 0;
-    double _periodTicks = 0.0;
     Listener *_listener = nullptr;
     bool _enabled = false;
-    double _lastTicks;
+    uint32_t _generation = 0;
+    uint64_t _lastTickUs = 0;
 };
@@ -13,8 +13,10 @@ public:
 
     typedef uint16_t Value;
 
-    Dac() :
-        _simulator(sim::Simulator::instance())
+    Dac() : Dac(sim::Simulator::current()) {}
+
+    Dac(sim::Simulator &simulator) :
+        _simulator(simulator)
     {}
 
     void init() {}
@@ -44,8 +44,10 @@ public:
         friend class Dio;
     };
 
-    Dio() :
-        _simulator(sim::Simulator::instance())
+    Dio() : Dio(sim::Simulator::current()) {}
+
+    Dio(sim::Simulator &simulator) :
+        _simulator(simulator)
     {
         _simulator.registerTargetInputObserver(this);
 
@@ -15,8 +15,10 @@ public:
         Up,     // encoder released
     };
 
-    Encoder() :
-        _simulator(sim::Simulator::instance())
+    Encoder() : Encoder(sim::Simulator::current()) {}
+
+    Encoder(sim::Simulator &simulator) :
+        _simulator(simulator)
     {
         _simulator.registerTargetInputObserver(this);
     }
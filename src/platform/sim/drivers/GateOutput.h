@@ -6,8 +6,10 @@
 
 class GateOutput {
 public:
-    GateOutput() :
-        _simulator(sim::Simulator::instance())
+    GateOutput() : GateOutput(sim::Simulator::current()) {}
+
+    GateOutput(sim::Simulator &simulator) :
+        _simulator(simulator)
     {}
 
     void init() {}
@@ -5,6 +5,8 @@
 
 #include "SystemConfig.h"
 
+#include <array>
+
 #include <cstdint>
 #include <cstring>
 
@@ -13,18 +15,65 @@ public:
     static constexpr int Width = CONFIG_LCD_WIDTH;
     static constexpr int Height = CONFIG_LCD_HEIGHT;
 
-    Lcd() :
-        _simulator(sim::Simulator::instance())
+    Lcd() : Lcd(sim::Simulator::current()) {}
+
+    Lcd(sim::Simulator &simulator) :
+        _simulator(simulator)
     {}
 
     void init() {}
 
-    void draw(uint8_t *frameBuffer) {
-        std::memcpy(_frameBuffer.data(), frameBuffer, _frameBuffer.size());
-        _simulator.writeLcd(_frameBuffer);
+    // sends the rows of a packed 4bpp frame buffer that changed since the last frame
+    void draw(const uint8_t *frameBuffer) {
+        bool changed = false;
+        int runFirst = -1;
+        for (int y = 0; y <= Height; ++y) {
+            bool rowChanged = false;
+            if (y < Height) {
+                const uint8_t *src = &frameBuffer[y * RowBytes];
+                uint8_t *dst = &_packedFrameBuffer[y * RowBytes];
+                rowChanged = !_frameBufferValid || std::memcmp(src, dst, RowBytes) != 0;
+                if (rowChanged) {
+                    std::memcpy(dst, src, RowBytes);
+                    unpackRow(y);
+                }
+            }
+            if (rowChanged && runFirst < 0) {
+                runFirst = y;
+            } else if (!rowChanged && runFirst >= 0) {
+                // same transfer as on the hardware: column/row window, write command and 4bpp pixel data
+                _bytesSent += WindowCommandBytes + (y - runFirst) * RowBytes;
+                runFirst = -1;
+                changed = true;
+            }
+        }
+        _frameBufferValid = true;
+
+        if (changed) {
+            _simulator.writeLcd(_frameBuffer);
+        }
     }
 
+    // number of bytes sent to the display
+    uint32_t bytesSent() const { return _bytesSent; }
+
 private:
+    static constexpr int RowBytes = Width / 2;
+    static constexpr int WindowCommandBytes = 7;
+
+    // expands a row to one byte per pixel as used by the simulator
+    void unpackRow(int y) {
+        const uint8_t *src = &_packedFrameBuffer[y * RowBytes];
+        uint8_t *dst = &_frameBuffer[y * Width];
+        for (int x = 0; x < RowBytes; ++x) {
+            *dst++ = src[x] >> 4;
+            *dst++ = src[x] & 0xf;
+        }
+    }
+
     sim::Simulator &_simulator;
+    std::array<uint8_t, RowBytes * Height> _packedFrameBuffer;
     sim::FrameBuffer _frameBuffer;
+    bool _frameBufferValid = false;
+    uint32_t _bytesSent = 0;
 };
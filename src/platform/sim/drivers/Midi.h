@@ -1,20 +1,33 @@
 #pragma once
 
 #include "core/midi/MidiMessage.h"
+#include "core/midi/MidiParser.h"
+#include "core/midi/MidiTxQueue.h"
 
 #include "sim/Simulator.h"
 
+#include <algorithm>
 #include <functional>
 #include <deque>
+#include <memory>
 
 #include <cstdint>
 
+// Models the DIN transmitter at 31250 baud, messages are written to the
+// simulator once their last byte has been transmitted.
+// Bytes are taken from the tx queue when their transmission starts, like the
+// usart interrupt on the hardware.
 class Midi : private sim::TargetInputHandler {
 public:
     typedef std::function<bool(uint8_t)> RecvFilter;
 
-    Midi() :
-        _simulator(sim::Simulator::instance())
+    // 10 bits per byte at 31250 baud
+    static constexpr uint32_t ByteTimeUs = 320;
+
+    Midi() : Midi(sim::Simulator::current()) {}
+
+    Midi(sim::Simulator &simulator) :
+        _simulator(simulator)
     {
         _simulator.registerTargetInputObserver(this);
     }
@@ -22,17 +35,33 @@ public:
     void init() {}
 
     bool send(const MidiMessage &message) {
-        _simulator.writeMidiOutput(sim::MidiEvent::makeMessage(0, message));
+        // block until there is space in the tx queue
+        while (!_txQueue.write(message)) {
+            sendNext();
+        }
+        startTx();
         return true;
     }
 
-    bool recv(MidiMessage *message) {
-        if (!_recvQueue.empty()) {
-            *message = _recvQueue.front();
-            _recvQueue.pop_front();
-            return true;
+    // sends a real-time byte ahead of queued messages
+    bool sendRealTime(uint8_t data) {
+        while (!_txQueue.writeRealTime(data)) {
+            sendNext();
         }
-        return false;
+        startTx();
+        return true;
+    }
+
+    bool recv(MidiMessage *message) {
+        return recv(message, 1) == 1;
+    }
+
+    // receives up to count messages, returns the number of messages received
+    size_t recv(MidiMessage *messages, size_t count) {
+        size_t received = std::min(_recvQueue.size(), count);
+        std::copy(_recvQueue.begin(), _recvQueue.begin() + received, messages);
+        _recvQueue.erase(_recvQueue.begin(), _recvQueue.begin() + received);
+        return received;
     }
 
     void setRecvFilter(RecvFilter filter) {
@@ -41,7 +70,40 @@ public:
 
     uint32_t rxOverflow() const { return 0; }
 
+    uint32_t txHighWatermark() const { return _txQueue.highWatermark(); }
+    uint32_t txBytesSaved() const { return _txQueue.bytesSaved(); }
+
 private:
+    // completes the byte being sent and starts the next one
+    void sendNext() {
+        if (_txParser.feed(_txData)) {
+            _simulator.writeMidiOutput(sim::MidiEvent::makeMessage(0, _txParser.message()));
+        }
+        if (_txQueue.read(_txData)) {
+            scheduleTx();
+        } else {
+            _txActive = false;
+        }
+    }
+
+    void startTx() {
+        if (!_txActive && _txQueue.read(_txData)) {
+            _txActive = true;
+            scheduleTx();
+        }
+    }
+
+    void scheduleTx() {
+        // the timer may outlive the driver and is invalidated by sending synchronously
+        std::weak_ptr<bool> alive = _alive;
+        uint32_t generation = ++_txGeneration;
+        _simulator.scheduleTimer(_simulator.timeUs() + ByteTimeUs, [this, alive, generation] () {
+            if (alive.lock() && generation == _txGeneration) {
+                sendNext();
+            }
+        });
+    }
+
     void writeMidiInput(sim::MidiEvent event) {
         if (event.port == 0 && event.kind == sim::MidiEvent::Message) {
             if (event.message.length() != 1 || !_recvFilter || !_recvFilter(event.message.status())) {
@@ -53,4 +115,11 @@ private:
     sim::Simulator &_simulator;
     std::deque<MidiMessage> _recvQueue;
     RecvFilter _recvFilter;
+
+    MidiTxQueue _txQueue;
+    MidiParser _txParser;
+    uint8_t _txData = 0;
+    bool _txActive = false;
+    uint32_t _txGeneration = 0;
+    std::shared_ptr<bool> _alive = std::make_shared<bool>(true);
 };
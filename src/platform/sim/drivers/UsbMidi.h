@@ -4,6 +4,7 @@
 
 #include "sim/Simulator.h"
 
+#include <algorithm>
 #include <functional>
 #include <deque>
 #include <memory>
@@ -16,8 +17,10 @@ public:
     typedef std::function<void()> DisconnectHandler;
     typedef std::function<bool(uint8_t)> RecvFilter;
 
-    UsbMidi() :
-        _simulator(sim::Simulator::instance())
+    UsbMidi() : UsbMidi(sim::Simulator::current()) {}
+
+    UsbMidi(sim::Simulator &simulator) :
+        _simulator(simulator)
     {
         _simulator.registerTargetInputObserver(this);
     }
@@ -29,13 +32,29 @@ public:
         return true;
     }
 
+    // usb transfers are not modelled, real-time bytes are sent immediately like all messages
+    bool sendRealTime(uint8_t data) {
+        return send(MidiMessage(data));
+    }
+
+    // sysex is sent in chunks of up to 3 bytes, the same as usb midi event packets
+    bool sendSysEx(const uint8_t *data, size_t length) {
+        MidiMessage::splitSysEx(data, length, [this] (const MidiMessage &chunk) {
+            _simulator.writeMidiOutput(sim::MidiEvent::makeMessage(1, chunk));
+        });
+        return true;
+    }
+
     bool recv(MidiMessage *message) {
-        if (!_recvQueue.empty()) {
-            *message = _recvQueue.front();
-            _recvQueue.pop_front();
-            return true;
-        }
-        return false;
+        return recv(message, 1) == 1;
+    }
+
+    // receives up to count messages, returns the number of messages received
+    size_t recv(MidiMessage *messages, size_t count) {
+        size_t received = std::min(_recvQueue.size(), count);
+        std::copy(_recvQueue.begin(), _recvQueue.begin() + received, messages);
+        _recvQueue.erase(_recvQueue.begin(), _recvQueue.begin() + received);
+        return received;
     }
 
     void setConnectHandler(ConnectHandler handler) {
@@ -4,49 +4,88 @@
 
 #include "sim/Simulator.h"
 
-#include <vector>
 #include <functional>
-#include <mutex>
+#include <memory>
 
 namespace os {
 
-    std::vector<std::function<void(void)>> &updateCallbacks();
-
     typedef int TaskHandle;
 
+    namespace detail {
+
+        // scheduler of the simulator running on the calling thread
+        inline sim::Scheduler *scheduler() {
+            return sim::Simulator::hasCurrent() ? &sim::Simulator::current().scheduler() : nullptr;
+        }
+
+        // blocks until condition is true or the timeout has elapsed
+        inline bool wait(std::function<bool()> condition, uint32_t timeToWait) {
+            if (auto scheduler = detail::scheduler()) {
+                return scheduler->wait(condition, timeToWait);
+            }
+            bool result = condition();
+            ASSERT(result || timeToWait != uint32_t(-1), "blocked forever");
+            return result;
+        }
+
+        // scheduling point after waking up other tasks
+        inline void preempt() {
+            if (auto scheduler = detail::scheduler()) {
+                scheduler->preempt();
+            }
+        }
+
+    } // namespace detail
+
     template<size_t StackSize>
     class Task {
     public:
         Task(const char *name, uint8_t priority, std::function<void(void)> func) :
-            _func(func)
+            _simulator(sim::Simulator::current())
         {
+            _handle = _simulator.createTask(name, priority, func);
         }
 
-        TaskHandle handle() const { return 0; }
+        ~Task() {
+            _simulator.destroyTask(_handle);
+        }
 
-    private:
-        std::function<void(void)> _func;
-    };
+        TaskHandle handle() const { return _handle; }
 
-    template<size_t StackSize>
-    class PeriodicTask {
-    public:
-        PeriodicTask(const char *name, uint8_t priority, uint32_t interval, std::function<void(void)> func) {
-            os::updateCallbacks().emplace_back(func);
+        const char *name() const { return _simulator.scheduler().taskName(_handle); }
+
+        size_t stackSize() const {
+            return StackSize;
         }
+
+    private:
+        sim::Simulator &_simulator;
+        TaskHandle _handle;
     };
 
-    inline void suspend(TaskHandle handle) {}
-    inline void resume(TaskHandle handle) {}
-    inline void resumeFromISR(TaskHandle handle) {}
+    inline void suspend(TaskHandle handle) { detail::scheduler()->suspend(handle); }
+    inline void resume(TaskHandle handle) { detail::scheduler()->resume(handle); }
+    inline void resumeFromISR(TaskHandle handle) { detail::scheduler()->resume(handle); }
 
     namespace this_task {
 
-        inline TaskHandle handle() { return -1; }
+        inline TaskHandle handle() {
+            auto scheduler = detail::scheduler();
+            return scheduler ? scheduler->currentTask() : -1;
+        }
+
+        inline const char *name() {
+            TaskHandle task = handle();
+            return task >= 0 ? detail::scheduler()->taskName(task) : "main";
+        }
 
-        inline void suspend() {}
-        inline void resume() {}
-        inline void yield() {}
+        inline void suspend() { os::suspend(handle()); }
+        inline void resume() { os::resume(handle()); }
+        inline void yield() {
+            if (auto scheduler = detail::scheduler()) {
+                scheduler->yield();
+            }
+        }
 
     } // namespace this_task
 
@@ -54,85 +93,139 @@ namespace os {
     class SemaphoreGeneric {
     public:
         bool take(uint32_t timeToWait = -1) {
-            return false;
+            if (!detail::wait([this] () { return _count > 0; }, timeToWait)) {
+                return false;
+            }
+            --_count;
+            return true;
         }
 
         bool give() {
-            return false;
+            if (_count >= _maxCount) {
+                return false;
+            }
+            ++_count;
+            detail::preempt();
+            return true;
         }
 
     protected:
-        SemaphoreGeneric() {}
+        SemaphoreGeneric(uint32_t maxCount, uint32_t initialCount) :
+            _count(initialCount),
+            _maxCount(maxCount)
+        {}
+
+        uint32_t _count;
+        uint32_t _maxCount;
     };
 
     class Semaphore : public SemaphoreGeneric {
     public:
-        Semaphore() {
-            ASSERT(false, "not implemented");
-        }
+        Semaphore() :
+            SemaphoreGeneric(1, 0)
+        {}
     };
 
     class CountingSemaphore : public SemaphoreGeneric {
     public:
-        CountingSemaphore(uint32_t maxCount = -1, uint32_t initialCount = 0) {
-            ASSERT(false, "not implemented");
-        }
+        CountingSemaphore(uint32_t maxCount = -1, uint32_t initialCount = 0) :
+            SemaphoreGeneric(maxCount, initialCount)
+        {}
+    };
+
+    class Mutex : public SemaphoreGeneric {
+    public:
+        Mutex() :
+            SemaphoreGeneric(1, 1)
+        {}
     };
 
-    class Mutex {
+    class RecursiveMutex {
     public:
         bool take(uint32_t timeToWait = -1) {
-            ASSERT(timeToWait == uint32_t(-1), "cannot wait for mutex");
-            _mutex.lock();
+            TaskHandle owner = this_task::handle();
+            if (_depth > 0 && _owner == owner) {
+                ++_depth;
+                return true;
+            }
+            if (!detail::wait([this] () { return _depth == 0; }, timeToWait)) {
+                return false;
+            }
+            _owner = owner;
+            _depth = 1;
             return true;
         }
 
         bool give() {
-            _mutex.unlock();
+            if (_depth == 0 || _owner != this_task::handle()) {
+                return false;
+            }
+            if (--_depth == 0) {
+                detail::preempt();
+            }
             return true;
         }
 
     private:
-        std::mutex _mutex;
-    };
-
-    class RecursiveMutex : public SemaphoreGeneric {
-    public:
-        RecursiveMutex() {
-            ASSERT(false, "not implemented");
-        }
+        TaskHandle _owner = -1;
+        uint32_t _depth = 0;
     };
 
     template<typename T, size_t Length>
     class Queue {
     public:
-        Queue() {
-            ASSERT(false, "not implemented");
-        }
-
         void send(const T& element, uint32_t timeToWait = -1) {
+            sendToBack(element, timeToWait);
         }
 
         void sendToBack(const T& element, uint32_t timeToWait = -1) {
+            if (!detail::wait([this] () { return _count < Length; }, timeToWait)) {
+                return;
+            }
+            _data[(_head + _count) % Length] = element;
+            ++_count;
+            detail::preempt();
         }
 
         void sendToFront(const T& element, uint32_t timeToWait = -1) {
+            if (!detail::wait([this] () { return _count < Length; }, timeToWait)) {
+                return;
+            }
+            _head = (_head + Length - 1) % Length;
+            _data[_head] = element;
+            ++_count;
+            detail::preempt();
         }
 
         bool peek(T * element, uint32_t timeToWait = -1) {
-            return false;
+            if (!detail::wait([this] () { return _count > 0; }, timeToWait)) {
+                return false;
+            }
+            *element = _data[_head];
+            return true;
         }
 
         bool receive(T * element, uint32_t timeToWait = -1) {
-            return false;
+            if (!detail::wait([this] () { return _count > 0; }, timeToWait)) {
+                return false;
+            }
+            *element = _data[_head];
+            _head = (_head + 1) % Length;
+            --_count;
+            detail::preempt();
+            return true;
         }
 
         T receive() {
-            return T(0);
+            T element = T();
+            receive(&element);
+            return element;
         }
 
     private:
         T _data[Length];
+        size_t _head = 0;
+        size_t _count = 0;
     };
 
     class InterruptLock {
@@ -151,20 +244,53 @@ namespace os {
     };
 
     inline uint32_t ticks() {
-        return sim::Simulator::instance().ticks();
+        return sim::Simulator::current().ticks();
     }
 
     inline void delay(uint32_t ticks) {
-        uint32_t wakeupTick = os::ticks() + ticks;
-        while (os::ticks() < wakeupTick) {}
+        sim::Simulator::current().scheduler().sleepUntil(os::ticks() + ticks);
     }
 
     inline void delayUntil(uint32_t &lastWakeupTime, uint32_t ticks) {
-        uint32_t wakeupTick = os::ticks() + ticks;
-        while (os::ticks() < wakeupTick) {}
+        lastWakeupTime += ticks;
+        sim::Simulator::current().scheduler().sleepUntil(lastWakeupTime);
     }
 
     inline void startScheduler() {
     }
 
+
+    // Runs as an update callback of the simulator by default, or as a scheduled task
+    // when the simulator is configured to use threaded tasks.
+    template<size_t StackSize>
+    class PeriodicTask {
+    public:
+        PeriodicTask(const char *name, uint8_t priority, uint32_t interval, std::function<void(void)> func) {
+            auto &simulator = sim::Simulator::current();
+            if (simulator.threadedTasks()) {
+                _task.reset(new Task<StackSize>(name, priority, [interval, func] () {
+                    uint32_t lastWakeupTime = os::ticks();
+                    while (true) {
+                        func();
+                        os::delayUntil(lastWakeupTime, interval);
+                    }
+                }));
+            } else {
+                // update callbacks run on every simulator update, keep the task interval
+                uint64_t intervalUs = uint64_t(interval) * 1000;
+                uint64_t nextTimeUs = simulator.timeUs();
+                simulator.addUpdateCallback([&simulator, intervalUs, nextTimeUs, func] () mutable {
+                    if (simulator.timeUs() < nextTimeUs) {
+                        return;
+                    }
+                    nextTimeUs += intervalUs;
+                    func();
+                });
+            }
+        }
+
+    private:
+        std::unique_ptr<Task<StackSize>> _task;
+    };
+
 } // namespace os
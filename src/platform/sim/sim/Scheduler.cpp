@@ -0,0 +1,287 @@
+#include "Scheduler.h"
+
+#include "core/Debug.h"
+
+namespace sim {
+
+enum class TaskState {
+    Ready,
+    Blocked,
+    Finished,
+};
+
+struct Scheduler::Task {
+    Scheduler *scheduler;
+    TaskId id;
+    std::string name;
+    uint8_t priority;
+    std::function<void()> func;
+    std::thread thread;
+    std::condition_variable wakeup;
+
+    TaskState state = TaskState::Ready;
+    bool suspended = false;
+
+    // blocking state
+    std::function<bool()> condition;
+    bool timeout = false;
+    uint32_t wakeupTick = 0;
+
+    // order among tasks of equal priority
+    uint32_t order = 0;
+
+    // destruction state
+    bool terminate = false;
+    Task *returnTo = nullptr;
+};
+
+thread_local Scheduler::Task *Scheduler::_currentTask = nullptr;
+
+Scheduler::Scheduler() {
+}
+
+Scheduler::~Scheduler() {
+    for (size_t id = 0; id < _tasks.size(); ++id) {
+        destroyTask(id);
+    }
+}
+
+Scheduler::TaskId Scheduler::createTask(const char *name, uint8_t priority, std::function<void()> func) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    std::unique_ptr<Task> task(new Task());
+    task->scheduler = this;
+    task->id = _tasks.size();
+    task->name = name;
+    task->priority = priority;
+    task->func = func;
+    task->order = _order++;
+    task->thread = std::thread(&Scheduler::entry, this, task.get());
+
+    _tasks.emplace_back(std::move(task));
+    return _tasks.size() - 1;
+}
+
+void Scheduler::destroyTask(TaskId id) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    Task *task = _tasks[id].get();
+    if (!task) {
+        return;
+    }
+
+    Task *self = current();
+    ASSERT(task != self, "task cannot destroy itself");
+
+    // hand the cpu to the task to let it unwind
+    if (task->state != TaskState::Finished) {
+        task->terminate = true;
+        task->returnTo = self;
+        switchTo(lock, self, task);
+    }
+
+    lock.unlock();
+    task->thread.join();
+    lock.lock();
+
+    _tasks[id].reset();
+}
+
+Scheduler::TaskId Scheduler::currentTask() const {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    Task *task = current();
+    return task ? task->id : -1;
+}
+
+const char *Scheduler::taskName(TaskId id) const {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    return _tasks[id] ? _tasks[id]->name.c_str() : "";
+}
+
+void Scheduler::suspend(TaskId id) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    Task &task = *_tasks[id];
+    task.suspended = true;
+
+    if (&task == current()) {
+        task.order = _order++;
+        switchTo(lock, &task, nextTask());
+    }
+}
+
+void Scheduler::resume(TaskId id) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    Task &task = *_tasks[id];
+    task.suspended = false;
+
+    Task *self = current();
+    if (self && isReady(task) && task.priority > self->priority) {
+        switchTo(lock, self, &task);
+    }
+}
+
+void Scheduler::run(uint32_t tick) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    ASSERT(!current(), "tasks cannot be run from a task");
+
+    _tick = tick;
+    switchTo(lock, nullptr, nextTask());
+}
+
+bool Scheduler::wait(std::function<bool()> condition, uint32_t timeout) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    if (condition()) {
+        return true;
+    }
+    if (timeout == 0) {
+        return false;
+    }
+
+    Task *task = current();
+
+    // time does not advance on the simulator thread, only let the tasks run
+    if (!task) {
+        switchTo(lock, nullptr, nextTask());
+        bool result = condition();
+        ASSERT(result || timeout != WaitForever, "simulator thread blocked forever");
+        return result;
+    }
+
+    task->condition = condition;
+    task->timeout = timeout != WaitForever;
+    task->wakeupTick = _tick + timeout;
+    block(lock, *task);
+    task->condition = nullptr;
+
+    return condition();
+}
+
+void Scheduler::sleepUntil(uint32_t tick) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    Task *task = current();
+    if (!task || int32_t(_tick - tick) >= 0) {
+        return;
+    }
+
+    task->condition = nullptr;
+    task->timeout = true;
+    task->wakeupTick = tick;
+    block(lock, *task);
+}
+
+void Scheduler::preempt() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    Task *self = current();
+    if (!self) {
+        return;
+    }
+
+    Task *next = nextTask();
+    if (next && next->priority > self->priority) {
+        switchTo(lock, self, next);
+    }
+}
+
+void Scheduler::yield() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    Task *self = current();
+    if (!self) {
+        return;
+    }
+
+    self->order = _order++;
+    switchTo(lock, self, nextTask());
+}
+
+Scheduler::Task *Scheduler::current() const {
+    return _currentTask && _currentTask->scheduler == this ? _currentTask : nullptr;
+}
+
+bool Scheduler::isReady(Task &task) const {
+    if (task.state == TaskState::Finished || task.terminate || task.suspended) {
+        return false;
+    }
+    if (task.state == TaskState::Ready) {
+        return true;
+    }
+    return (task.condition && task.condition()) || (task.timeout && int32_t(_tick - task.wakeupTick) >= 0);
+}
+
+Scheduler::Task *Scheduler::nextTask() const {
+    Task *next = nullptr;
+    for (const auto &task : _tasks) {
+        if (!task || !isReady(*task)) {
+            continue;
+        }
+        if (!next || task->priority > next->priority || (task->priority == next->priority && int32_t(task->order - next->order) < 0)) {
+            next = task.get();
+        }
+    }
+    return next;
+}
+
+void Scheduler::entry(Task *task) {
+    _currentTask = task;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    task->wakeup.wait(lock, [&] () { return _running == task; });
+
+    if (!task->terminate) {
+        lock.unlock();
+        try {
+            task->func();
+        } catch (const TaskExit &) {
+        }
+        lock.lock();
+    }
+
+    task->state = TaskState::Finished;
+
+    Task *next = task->terminate ? task->returnTo : nextTask();
+    _running = next;
+    if (next) {
+        next->wakeup.notify_one();
+    } else {
+        _simulatorCondition.notify_one();
+    }
+}
+
+void Scheduler::block(std::unique_lock<std::mutex> &lock, Task &task) {
+    task.state = TaskState::Blocked;
+    task.order = _order++;
+    switchTo(lock, &task, nextTask());
+    task.state = TaskState::Ready;
+}
+
+void Scheduler::switchTo(std::unique_lock<std::mutex> &lock, Task *self, Task *next) {
+    if (next == self) {
+        return;
+    }
+
+    _running = next;
+    if (next) {
+        next->wakeup.notify_one();
+    } else {
+        _simulatorCondition.notify_one();
+    }
+
+    if (self) {
+        self->wakeup.wait(lock, [&] () { return _running == self; });
+        if (self->terminate) {
+            throw TaskExit();
+        }
+    } else {
+        _simulatorCondition.wait(lock, [&] () { return _running == nullptr; });
+    }
+}
+
+} // namespace sim
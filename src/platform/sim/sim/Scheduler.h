@@ -0,0 +1,81 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cstdint>
+
+namespace sim {
+
+// Thread backed task scheduler emulating the single core, fixed priority scheduling of FreeRTOS.
+// Each task runs on its own thread, but only one thread (either a task or the simulator thread)
+// owns the cpu at any time. On every tick, the simulator hands the cpu to the ready tasks, which
+// then run in priority order until all of them are blocked. Blocking calls and calls that wake up
+// other tasks are scheduling points, a running task is preempted as soon as a task with higher
+// priority becomes ready. Simulated time does not advance while tasks are running.
+class Scheduler {
+public:
+    typedef int TaskId;
+
+    static constexpr uint32_t WaitForever = uint32_t(-1);
+
+    Scheduler();
+    ~Scheduler();
+
+    TaskId createTask(const char *name, uint8_t priority, std::function<void()> func);
+    void destroyTask(TaskId id);
+
+    // returns the task owning the calling thread, -1 if not called from a task
+    TaskId currentTask() const;
+
+    const char *taskName(TaskId id) const;
+
+    void suspend(TaskId id);
+    void resume(TaskId id);
+
+    // runs all ready tasks until they are blocked (called by the simulator once per tick)
+    void run(uint32_t tick);
+
+    // blocks the calling task until condition is true or the timeout (in ticks) has elapsed
+    // returns the final state of the condition
+    bool wait(std::function<bool()> condition, uint32_t timeout = WaitForever);
+
+    // blocks the calling task until the given tick
+    void sleepUntil(uint32_t tick);
+
+    // gives the cpu to a task with higher priority if one became ready
+    void preempt();
+
+    // gives the cpu to the next ready task with the same or higher priority
+    void yield();
+
+private:
+    struct Task;
+
+    // unwinds a task that is destroyed while blocked
+    struct TaskExit {};
+
+    Task *current() const;
+    bool isReady(Task &task) const;
+    Task *nextTask() const;
+
+    void entry(Task *task);
+    void block(std::unique_lock<std::mutex> &lock, Task &task);
+    void switchTo(std::unique_lock<std::mutex> &lock, Task *self, Task *next);
+
+    mutable std::mutex _mutex;
+    std::condition_variable _simulatorCondition;
+    std::vector<std::unique_ptr<Task>> _tasks;
+    Task *_running = nullptr;
+    uint32_t _tick = 0;
+    uint32_t _order = 0;
+
+    static thread_local Task *_currentTask;
+};
+
+} // namespace sim
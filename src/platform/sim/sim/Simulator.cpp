@@ -2,7 +2,7 @@
 
 #include "libs/stb/stb_image_write.h"
 
-#include "os/os.h"
+#include "core/Debug.h"
 
 #include "core/midi/MidiMessage.h"
 
@@ -11,33 +11,56 @@
 #include <iomanip>
 #include <algorithm>
 #include <iostream>
+#include <chrono>
 
 #include <cmath>
 
 namespace sim {
 
-static Simulator *g_instance;
+// Each simulator binds itself to the calling thread while running the target.
+// This allows multiple simulators to run in parallel on separate threads.
+static thread_local Simulator *g_current;
+
+struct CurrentScope {
+    CurrentScope(Simulator *simulator) : _prev(g_current) { g_current = simulator; }
+    ~CurrentScope() { g_current = _prev; }
+    Simulator *_prev;
+};
 
 Simulator::Simulator(Target target) :
     _target(target),
     _targetStateTracker(_targetState)
 {
-    g_instance = this;
-
     registerTargetInputObserver(&_targetStateTracker);
     registerTargetOutputObserver(&_targetStateTracker);
 }
 
 Simulator::~Simulator() {
     if (_targetCreated) {
-       _target.destroy();
+        CurrentScope scope(this);
+        _target.destroy();
     }
 }
 
 void Simulator::wait(int ms) {
-    while (ms--) {
+    uint64_t endUs = _timeUs + ms * uint64_t(1000);
+    while (_updateTimeUs < endUs) {
         step();
     }
+    advance(endUs);
+}
+
+Simulator::RunStats Simulator::run(int ms) {
+    RunStats stats;
+
+    auto start = std::chrono::steady_clock::now();
+    wait(ms);
+    auto end = std::chrono::steady_clock::now();
+
+    stats.simulatedMs = ms;
+    stats.wallMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    return stats;
 }
 
 void Simulator::setButton(int index, bool pressed) {
@@ -84,13 +107,30 @@ void Simulator::screenshot(const std::string &filename) {
 }
 
 double Simulator::ticks() {
-    return _tick;
+    return _timeUs * 0.001;
 }
 
 void Simulator::addUpdateCallback(UpdateCallback callback) {
     _updateCallbacks.emplace_back(callback);
 }
 
+void Simulator::scheduleTimer(uint64_t timeUs, TimerCallback callback) {
+    // timers with equal time fire in the order they were scheduled
+    _timers.emplace(std::max(timeUs, _timeUs), callback);
+}
+
+Scheduler::TaskId Simulator::createTask(const char *name, uint8_t priority, std::function<void()> func) {
+    // bind the simulator to the task thread
+    return _scheduler.createTask(name, priority, [this, func] () {
+        CurrentScope scope(this);
+        func();
+    });
+}
+
+void Simulator::destroyTask(Scheduler::TaskId id) {
+    _scheduler.destroyTask(id);
+}
+
 void Simulator::registerTargetTickObserver(TargetTickHandler *observer) {
     _targetTickObservers.emplace_back(observer);
 }
@@ -173,31 +213,54 @@ void Simulator::writeMidiOutput(MidiEvent event) {
     }
 }
 
-Simulator &Simulator::instance() {
-    return *g_instance;
+Simulator &Simulator::current() {
+    ASSERT(g_current, "no simulator running on this thread");
+    return *g_current;
+}
+
+bool Simulator::hasCurrent() {
+    return g_current != nullptr;
 }
 
 void Simulator::step() {
+    CurrentScope scope(this);
+
     if (!_targetCreated) {
         _target.create();
         _targetCreated = true;
     }
 
-    for (auto observer : _targetTickObservers) {
-        observer->setTick(_tick);
-    }
+    advance(_updateTimeUs);
 
-    for (const auto &callback : os::updateCallbacks()) {
-        callback();
+    uint32_t tick = _timeUs / 1000;
+
+    for (auto observer : _targetTickObservers) {
+        observer->setTick(tick);
     }
 
     for (const auto &callback : _updateCallbacks) {
         callback();
     }
 
+    _scheduler.run(tick);
+
     _target.update();
 
-    _tick += 1;
+    _updateTimeUs += _updateIntervalUs;
+}
+
+void Simulator::advance(uint64_t timeUs) {
+    CurrentScope scope(this);
+
+    // fire timers at their exact time
+    while (!_timers.empty() && _timers.begin()->first <= timeUs) {
+        auto it = _timers.begin();
+        auto callback = it->second;
+        _timeUs = it->first;
+        _timers.erase(it);
+        callback();
+    }
+    _timeUs = std::max(_timeUs, timeUs);
 }
 
 } // namespace sim
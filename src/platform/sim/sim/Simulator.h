@@ -1,11 +1,13 @@
 #pragma once
 
+#include "Scheduler.h"
 #include "Target.h"
 #include "TargetStateTracker.h"
 #include "TargetTrace.h"
 
 #include <array>
 #include <functional>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -15,10 +17,21 @@ namespace sim {
 
 class Simulator : public TargetInputHandler, public TargetOutputHandler {
 public:
+    struct RunStats {
+        uint32_t simulatedMs = 0;
+        double wallMs = 0.0;
+
+        // simulated milliseconds per wall clock millisecond
+        double speed() const { return wallMs > 0.0 ? simulatedMs / wallMs : 0.0; }
+    };
+
     Simulator(Target target);
     ~Simulator();
 
     void wait(int ms);
+
+    // runs the target for the given simulated time as fast as possible
+    RunStats run(int ms);
     void setButton(int index, bool pressed);
     void setEncoder(bool pressed);
     void rotateEncoder(int direction);
@@ -30,12 +43,38 @@ public:
 
     const TargetState &targetState() const { return _targetState; }
 
+    // Time
+
+    // simulated time in milliseconds (os ticks)
     double ticks();
+    // simulated time in microseconds
+    uint64_t timeUs() const { return _timeUs; }
+
+    // interval between updates of the target (set before the target is created)
+    void setUpdateInterval(uint32_t us) { _updateIntervalUs = us; }
+    uint32_t updateInterval() const { return _updateIntervalUs; }
 
     typedef std::function<void()> UpdateCallback;
 
+    // called on each update before the target is updated
     void addUpdateCallback(UpdateCallback callback);
 
+    typedef std::function<void()> TimerCallback;
+
+    // calls the callback at the given simulated time, independent of the update interval
+    void scheduleTimer(uint64_t timeUs, TimerCallback callback);
+
+    // Tasks
+
+    // runs periodic tasks on the scheduler instead of as update callbacks (set before the target is created)
+    void setThreadedTasks(bool threadedTasks) { _threadedTasks = threadedTasks; }
+    bool threadedTasks() const { return _threadedTasks; }
+
+    Scheduler &scheduler() { return _scheduler; }
+
+    Scheduler::TaskId createTask(const char *name, uint8_t priority, std::function<void()> func);
+    void destroyTask(Scheduler::TaskId id);
+
     // Target input/output handling
 
     void registerTargetTickObserver(TargetTickHandler *observer);
@@ -57,21 +96,30 @@ public:
     void writeLcd(const FrameBuffer &frameBuffer) override;
     void writeMidiOutput(MidiEvent event) override;
 
-    static Simulator &instance();
+    // simulator currently running the target on the calling thread
+    static Simulator &current();
+    static bool hasCurrent();
 
 private:
     void step();
+    void advance(uint64_t timeUs);
 
     Target _target;
     bool _targetCreated = false;
 
-    uint32_t _tick = 0;
+    uint64_t _timeUs = 0;
+    uint32_t _updateIntervalUs = 1000;
+    uint64_t _updateTimeUs = 0;
 
     std::vector<TargetTickHandler *> _targetTickObservers;
     std::vector<TargetInputHandler *> _targetInputObservers;
     std::vector<TargetOutputHandler *> _targetOutputObservers;
 
     std::vector<UpdateCallback> _updateCallbacks;
+    std::multimap<uint64_t, TimerCallback> _timers;
+
+    bool _threadedTasks = false;
+    Scheduler _scheduler;
 
     TargetState _targetState;
     TargetStateTracker _targetStateTracker;
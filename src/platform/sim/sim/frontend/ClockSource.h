@@ -9,43 +9,41 @@ public:
     ClockSource(Simulator &simulator, std::function<void()> handler) :
         _simulator(simulator),
         _handler(handler)
-    {
-        _simulator.addUpdateCallback([this] () { update(); });
-    }
+    {}
 
     void toggle() {
         _active = !_active;
+        ++_generation;
         if (_active) {
-            _lastTicks = _simulator.ticks();
+            schedule(_simulator.timeUs());
         }
     }
 
-    void update() {
-        if (_active) {
-            double currentTicks = _simulator.ticks();
-            double interval = clockInterval() * 1000.0;
-            while (_lastTicks <= currentTicks + interval) {
-                if (_handler) {
-                    _handler();
-                }
-                _lastTicks += interval;
+private:
+    void schedule(uint64_t timeUs) {
+        uint32_t generation = _generation;
+        _simulator.scheduleTimer(timeUs, [this, generation, timeUs] () {
+            if (generation != _generation) {
+                return;
             }
-        }
+            schedule(timeUs + clockIntervalUs());
+            if (_handler) {
+                _handler();
+            }
+        });
     }
 
-private:
-    double clockInterval() {
-        return 60.0 / (_bpm * _ppqn);
+    uint64_t clockIntervalUs() {
+        return uint64_t(60000000.0 / (_bpm * _ppqn));
     }
 
     Simulator &_simulator;
     std::function<void()> _handler;
 
     bool _active = false;
+    uint32_t _generation = 0;
     int _ppqn = 16;
     double _bpm = 120.0;
-
-    double _lastTicks;
 };
 
 } // namespace sim
@@ -13,9 +13,14 @@
 #include "sim/TargetConfig.h"
 #include "sim/TargetUtils.h"
 
+#include "core/profiler/Profiler.h"
+
+#include "drivers/HighResolutionTimer.h"
+
 #include "args.hxx"
 #include "tinyformat.h"
 
+#include <fstream>
 #include <memory>
 #include <sstream>
 #include <iomanip>
@@ -39,8 +44,6 @@ static void addWidget(std::vector<T> &list, T widget, int index) {
 Frontend::Frontend(Simulator &simulator) :
     _simulator(simulator)
 {
-    SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_TIMER);
-
 #ifdef __EMSCRIPTEN__
     g_instance = this;
 #endif
@@ -54,6 +57,11 @@ int Frontend::main(int argc, char *argv[]) {
     args::ArgumentParser parser("PER|FORMER Simulator", "");
     args::HelpFlag help(parser, "help", "Display this help menu", { 'h', "help" });
     args::Flag showMidiPorts(parser, "midi", "Show available MIDI ports", { 'm', "midi" });
+    args::Flag headless(parser, "headless", "Run without frontend as fast as possible", { "headless" });
+    args::ValueFlag<int> duration(parser, "ms", "Simulated time to run in headless mode (default 60000)", { 'd', "duration" }, 60000);
+    args::Flag threaded(parser, "threaded", "Run tasks on prioritized threads like on the hardware", { "threaded" });
+    args::ValueFlag<int> updateInterval(parser, "us", "Interval between updates of the target (default 1000)", { "update-interval" }, 1000);
+    args::ValueFlag<std::string> trace(parser, "file", "Record a profiler timeline and write it as chrome trace json on exit", { "trace" });
 
     try {
         parser.ParseCLI(argc, argv);
@@ -66,14 +74,33 @@ int Frontend::main(int argc, char *argv[]) {
         return 1;
     }
 
+    if (args::get(updateInterval) <= 0) {
+        std::cerr << "update interval must be positive" << std::endl;
+        return 1;
+    }
+
+    _simulator.setThreadedTasks(bool(threaded));
+    _simulator.setUpdateInterval(args::get(updateInterval));
+
     if (showMidiPorts) {
         _midi.dumpPorts();
         return 0;
     }
 
+    if (trace) {
+        HighResolutionTimer::init();
+        Profiler::setEnabled(true);
+    }
 
+    if (headless) {
+        runHeadless(args::get(duration));
+    } else {
+        run();
+    }
 
-    run();
+    if (trace) {
+        writeTrace(args::get(trace));
+    }
 
     return 0;
 }
@@ -97,6 +124,20 @@ void Frontend::run() {
 #endif
 }
 
+void Frontend::runHeadless(int ms) {
+    auto stats = _simulator.run(ms);
+
+    std::cout << tfm::format("simulated %d ms in %.1f ms (%.1f simulated ms per wall ms)", stats.simulatedMs, stats.wallMs, stats.speed()) << std::endl;
+}
+
+void Frontend::writeTrace(const std::string &filename) {
+    std::ofstream file(filename);
+    Profiler::writeChromeTrace([&file] (const char *str) {
+        file << str;
+    });
+    std::cout << tfm::format("profiler trace written to '%s'", filename) << std::endl;
+}
+
 void Frontend::close() {
     _window->close();
 }
@@ -143,6 +184,8 @@ double Frontend::ticks() const {
 }
 
 void Frontend::setup() {
+    SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_TIMER);
+
     _timerFrequency = SDL_GetPerformanceFrequency();
     _timerStart = SDL_GetPerformanceCounter();
 
@@ -403,8 +446,9 @@ void Frontend::setupMidi() {
 }
 
 void Frontend::setupInstruments() {
-    // _instruments.reset(new SamplerSetup(_audio));
-    _instruments.reset(new MixedSetup(_audio));
+    _audio.reset(new Audio());
+    // _instruments.reset(new SamplerSetup(*_audio));
+    _instruments.reset(new MixedSetup(*_audio));
 }
 
 // TargetInputHandler
@@ -475,7 +519,15 @@ void Frontend::writeMidiOutput(MidiEvent event) {
             _midiPort->send(message.raw(), message.length());
             break;
         case 1:
-            _usbMidiPort->send(message.raw(), message.length());
+            if (message.isSystemExclusive() || (!_usbMidiSysEx.empty() && !message.isRealTimeMessage())) {
+                _usbMidiSysEx.insert(_usbMidiSysEx.end(), message.raw(), message.raw() + message.length());
+                if (_usbMidiSysEx.back() == MidiMessage::EndOfExclusive) {
+                    _usbMidiPort->send(_usbMidiSysEx.data(), _usbMidiSysEx.size());
+                    _usbMidiSysEx.clear();
+                }
+            } else {
+                _usbMidiPort->send(message.raw(), message.length());
+            }
             break;
         }
     }
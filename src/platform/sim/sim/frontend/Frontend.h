@@ -32,6 +32,7 @@ public:
     int main(int argc, char *argv[]);
 
     void run();
+    void runHeadless(int ms);
 
     void close();
 
@@ -41,6 +42,7 @@ private:
     void update();
     void render();
     void delay(int ms);
+    void writeTrace(const std::string &filename);
 
     double ticks() const;
 
@@ -68,7 +70,7 @@ private:
     void writeMidiOutput(MidiEvent event) override;
 
     Simulator &_simulator;
-    Audio _audio;
+    std::unique_ptr<Audio> _audio;
     std::unique_ptr<InstrumentSetup> _instruments;
 
     double _timerFrequency;
@@ -80,6 +82,8 @@ private:
     Midi _midi;
     std::shared_ptr<Midi::Port> _midiPort;
     std::shared_ptr<Midi::Port> _usbMidiPort;
+    // sysex chunks are collected and sent as a single message
+    std::vector<uint8_t> _usbMidiSysEx;
 
     std::unique_ptr<ClockSource> _clockSource;
 
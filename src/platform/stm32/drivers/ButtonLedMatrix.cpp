@@ -14,20 +14,35 @@ ButtonLedMatrix::ButtonLedMatrix(ShiftRegister &shiftRegister, bool invertLeds)
 void ButtonLedMatrix::init() {
     std::memset(_buttonState, 0, sizeof(_buttonState));
     std::memset(_ledState, 0, sizeof(_ledState));
+    _leds.fill({ 0, 0 });
+    _dirtyRows = 0xff;
+    _dimmedRows = 0;
 }
 
 void ButtonLedMatrix::process() {
     uint8_t rowData = ~(1 << _row);
-    uint8_t ledData = 0;
-    for (int col = 0; col < ColsLed; ++col) {
-        int index = col * Rows + _row;
-        if (_ledState[index].red.update()) {
-            ledData |= (1 << (col * 2 + 1));
-        }
-        if (_ledState[index].green.update()) {
-            ledData |= (1 << (col * 2));
+    uint8_t rowMask = 1 << _row;
+    if ((_dirtyRows | _dimmedRows) & rowMask) {
+        // clear before reading the led state to not miss concurrent changes
+        _dirtyRows &= ~rowMask;
+        uint8_t ledData = 0;
+        bool dimmed = false;
+        for (int col = 0; col < ColsLed; ++col) {
+            int index = col * Rows + _row;
+            auto &led = _ledState[index];
+            if (led.red.update()) {
+                ledData |= (1 << (col * 2 + 1));
+            }
+            if (led.green.update()) {
+                ledData |= (1 << (col * 2));
+            }
+            dimmed |= (led.red.intensity != 0 && led.red.intensity != 0xf) ||
+                      (led.green.intensity != 0 && led.green.intensity != 0xf);
         }
+        _rowLedData[_row] = ledData;
+        _dimmedRows = dimmed ? (_dimmedRows | rowMask) : (_dimmedRows & ~rowMask);
     }
+    uint8_t ledData = _rowLedData[_row];
 
     uint8_t buttonData = _shiftRegister.read(0);
     _shiftRegister.write(0, rowData);
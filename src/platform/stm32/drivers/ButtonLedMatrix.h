@@ -52,15 +52,20 @@ public:
         if (green == 0) {
             _ledState[index].green.counter = 0;
         }
+        _dirtyRows |= 1 << (index % Rows);
     }
 
     inline void setLed(int row, int col, uint8_t red, uint8_t green) {
         setLed(col * Rows + row, red, green);
     }
 
+    // only changed leds are updated
     void setLeds(const std::array<std::pair<uint8_t, uint8_t>, Rows * ColsLed> &leds) {
         for (size_t i = 0; i < leds.size(); ++i) {
-            setLed(i, leds[i].first, leds[i].second);
+            if (leds[i] != _leds[i]) {
+                _leds[i] = leds[i];
+                setLed(i, leds[i].first, leds[i].second);
+            }
         }
     }
 
@@ -110,6 +115,13 @@ private:
 
     ButtonState _buttonState[Rows * ColsButton];
     LedState _ledState[Rows * ColsLed];
+    std::array<std::pair<uint8_t, uint8_t>, Rows * ColsLed> _leds;
+
+    // rows with dimmed leds need their pwm counters updated on every scan,
+    // other rows reuse their led data until one of their leds changes
+    uint8_t _rowLedData[Rows];
+    volatile uint8_t _dirtyRows = 0xff;
+    uint8_t _dimmedRows = 0;
 
     RingBuffer<Event, 16> _events;
 
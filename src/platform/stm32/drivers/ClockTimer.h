@@ -1,5 +1,7 @@
 #pragma once
 
+#include "HighResolutionTimer.h"
+
 #include <cstdint>
 
 class ClockTimer {
@@ -19,6 +21,9 @@ public:
 
     void setListener(Listener *listener);
 
+    // current time used to measure timer accuracy
+    uint32_t timeUs() const { return HighResolutionTimer::us(); }
+
 private:
     uint32_t _period = 0;
 };
@@ -11,6 +11,7 @@
 #include <libopencm3/stm32/dma.h>
 
 #include <cmath>
+#include <cstring>
 #include <algorithm>
 
 #define LCD_PORT GPIOB
@@ -65,6 +66,8 @@ static InitCommand initCommands[] = {
     { 0x00 }
 };
 
+static Lcd *g_lcd;
+
 #ifdef LCD_USE_DMA
 static volatile uint32_t txDone = 1;
 #endif // LCD_USE_DMA
@@ -76,6 +79,8 @@ static inline void waitTxDone() {
 
 
 void Lcd::init() {
+    g_lcd = this;
+
     // init spi pins
     rcc_periph_clock_enable(RCC_GPIOB);
     rcc_periph_clock_enable(RCC_GPIOC);
@@ -123,37 +128,79 @@ void Lcd::init() {
     initialize();
 }
 
-void Lcd::draw(uint8_t *frameBuffer) {
+void Lcd::draw(const uint8_t *frameBuffer) {
 #ifdef LCD_USE_DMA
     // wait until previous frame is sent
     while (!txDone) {}
-    txDone = 0;
 #endif // LCD_USE_DMA
 
-    // copy buffer
-    uint8_t *src = frameBuffer;
+    // copy buffer and collect runs of changed rows
+    _runCount = 0;
+    const uint8_t *src = frameBuffer;
     uint8_t *dst = reinterpret_cast<uint8_t *>(_frameBuffer);
-    for (int i = 0; i < Width * Height / 2; ++i) {
-        uint8_t a = *src++;
-        uint8_t b = *src++;
-        *dst++ = std::min(b, uint8_t(15)) | (std::min(a, uint8_t(15)) << 4);
-        // *dst++ = (b >> 4) | ((a >> 4) << 4);
+    for (int y = 0; y < Height; ++y, src += RowBytes, dst += RowBytes) {
+        if (!_frameBufferValid || std::memcmp(src, dst, RowBytes) != 0) {
+            std::memcpy(dst, src, RowBytes);
+            if (_runCount > 0 && _runs[_runCount - 1].last == y - 1) {
+                _runs[_runCount - 1].last = y;
+            } else {
+                _runs[_runCount++] = { uint8_t(y), uint8_t(y) };
+            }
+        }
     }
+    _frameBufferValid = true;
 
+    if (_runCount == 0) {
+        return;
+    }
 
 #ifdef LCD_USE_DMA
+    txDone = 0;
+    _runIndex = 0;
+    sendRun(_runs[_runIndex++]);
+#else // LCD_USE_DMA
+    for (int i = 0; i < _runCount; ++i) {
+        sendRun(_runs[i]);
+    }
+#endif // LCD_USE_DMA
+}
+
+void Lcd::handleIrq() {
+#ifdef LCD_USE_DMA
+    if (dma_get_interrupt_flag(LCD_DMA, LCD_DMA_STREAM, DMA_TCIF)) {
+        dma_clear_interrupt_flags(LCD_DMA, LCD_DMA_STREAM, DMA_TCIF);
+        dma_disable_stream(LCD_DMA, LCD_DMA_STREAM);
+
+        spi_disable_tx_dma(LCD_SPI);
+
+        waitTxDone();
+
+        if (_runIndex < _runCount) {
+            sendRun(_runs[_runIndex++]);
+        } else {
+            txDone = 1;
+        }
+    }
+#endif // LCD_USE_DMA
+}
+
+void Lcd::sendRun(const Run &run) {
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(_frameBuffer) + run.first * RowBytes;
+    size_t length = (run.last - run.first + 1) * RowBytes;
 
     setColAddr(0x1c,0x5b);
-    setRowAddr(0x00,0x3f);
+    setRowAddr(run.first, run.last);
     setWrite();
 
+#ifdef LCD_USE_DMA
+
     waitTxDone();
     gpio_set(LCD_PORT, LCD_DC);
 
     dma_stream_reset(LCD_DMA, LCD_DMA_STREAM);
     dma_set_peripheral_address(LCD_DMA, LCD_DMA_STREAM, reinterpret_cast<uint32_t>(&LCD_SPI_DR));
-    dma_set_memory_address(LCD_DMA, LCD_DMA_STREAM, reinterpret_cast<uint32_t>(_frameBuffer));
-    dma_set_number_of_data(LCD_DMA, LCD_DMA_STREAM, sizeof(_frameBuffer));
+    dma_set_memory_address(LCD_DMA, LCD_DMA_STREAM, reinterpret_cast<uint32_t>(data));
+    dma_set_number_of_data(LCD_DMA, LCD_DMA_STREAM, length);
     dma_channel_select(LCD_DMA, LCD_DMA_STREAM, LCD_DMA_CHANNEL);
     dma_set_priority(LCD_DMA, LCD_DMA_STREAM, DMA_SxCR_PL_HIGH);
 
@@ -170,17 +217,12 @@ void Lcd::draw(uint8_t *frameBuffer) {
 
     spi_enable_tx_dma(LCD_SPI);
 
-#else // LCD_USE_DMA
+    _bytesSent += length;
 
-    setColAddr(0x1c,0x5b);
-    setRowAddr(0x00,0x3f);
-    setWrite();
+#else // LCD_USE_DMA
 
-    src = reinterpret_cast<uint8_t *>(_frameBuffer);
-    for (int y = 0; y < Height; y++) {
-        for (int x = 0; x < Width/2; x++) {
-            sendData(*src++);
-        }
+    for (size_t i = 0; i < length; ++i) {
+        sendData(*data++);
     }
 
 #endif // LCD_USE_DMA
@@ -190,12 +232,14 @@ void Lcd::sendCmd(uint8_t cmd) {
     waitTxDone();
     gpio_clear(LCD_PORT, LCD_DC);
     spi_send(LCD_SPI, cmd);
+    ++_bytesSent;
 }
 
 void Lcd::sendData(uint8_t data) {
     waitTxDone();
     gpio_set(LCD_PORT, LCD_DC);
     spi_send(LCD_SPI, data);
+    ++_bytesSent;
 }
 
 void Lcd::initialize() {
@@ -230,15 +274,6 @@ void Lcd::setWrite() {
 
 #ifdef LCD_USE_DMA
 void dma1_stream4_isr(void) {
-    if (dma_get_interrupt_flag(LCD_DMA, LCD_DMA_STREAM, DMA_TCIF)) {
-        dma_clear_interrupt_flags(LCD_DMA, LCD_DMA_STREAM, DMA_TCIF);
-        dma_disable_stream(LCD_DMA, LCD_DMA_STREAM);
-
-        spi_disable_tx_dma(LCD_SPI);
-
-        waitTxDone();
-
-        txDone = 1;
-    }
+    g_lcd->handleIrq();
 }
 #endif // LCD_USE_DMA
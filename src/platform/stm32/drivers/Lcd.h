@@ -12,9 +12,24 @@ public:
 
     void init();
 
-    void draw(uint8_t *frameBuffer);
+    // sends the rows of a packed 4bpp frame buffer that changed since the last frame
+    void draw(const uint8_t *frameBuffer);
+
+    // number of bytes sent to the display
+    uint32_t bytesSent() const { return _bytesSent; }
+
+    void handleIrq();
 
 private:
+    static constexpr int RowBytes = Width / 2;
+
+    struct Run {
+        uint8_t first;
+        uint8_t last;
+    };
+
+    void sendRun(const Run &run);
+
     void sendCmd(uint8_t cmd);
     void sendData(uint8_t data);
 
@@ -24,5 +39,14 @@ private:
     void setRowAddr(uint8_t a, uint8_t b);
     void setWrite();
 
-    uint32_t _frameBuffer[Width * Height / 8];
+    // last frame sent to the display (4bpp)
+    uint32_t _frameBuffer[RowBytes * Height / 4];
+    bool _frameBufferValid = false;
+
+    // runs of changed rows
+    Run _runs[Height / 2];
+    int _runCount = 0;
+    int _runIndex = 0;
+
+    uint32_t _bytesSent = 0;
 };
@@ -9,6 +9,8 @@
 #include <libopencm3/stm32/usart.h>
 #include <libopencm3/cm3/nvic.h>
 
+#include <algorithm>
+
 #define MIDI_USART USART6
 
 static Midi *g_midi = nullptr;
@@ -38,10 +40,26 @@ void Midi::init() {
 }
 
 bool Midi::send(const MidiMessage &message) {
-    for (uint8_t i = 0; i < message.length(); ++i) {
-        send(message.raw()[i]);
+    os::InterruptLock lock;
+
+    // block until there is space in the tx queue
+    while (!_txQueue.write(message)) {
+        sendNext();
+    }
+
+    startTx();
+    return true;
+}
+
+bool Midi::sendRealTime(uint8_t data) {
+    os::InterruptLock lock;
+
+    // block until there is space in the tx queue
+    while (!_txQueue.writeRealTime(data)) {
+        sendNext();
     }
 
+    startTx();
     return true;
 }
 
@@ -55,26 +73,37 @@ bool Midi::recv(MidiMessage *message) {
     return false;
 }
 
+size_t Midi::recv(MidiMessage *messages, size_t count) {
+    uint8_t data[16];
+    size_t received = 0;
+    while (received < count && !_rxBuffer.empty()) {
+        // each byte completes at most one message
+        size_t length = std::min(std::min(_rxBuffer.readable(), sizeof(data)), count - received);
+        _rxBuffer.read(data, length);
+        _midiParser.feed(data, length, [&] (const MidiMessage &message) {
+            messages[received++] = message;
+        });
+    }
+    return received;
+}
+
 void Midi::setRecvFilter(RecvFilter filter) {
     _recvFilter = filter;
 }
 
-void Midi::send(uint8_t data) {
-    os::InterruptLock lock;
-
-    // block until there is space in the tx buffer
-    while (_txBuffer.full()) {
+void Midi::sendNext() {
+    uint8_t data;
+    if (_txQueue.read(data)) {
         usart_wait_send_ready(MIDI_USART);
-        usart_send(MIDI_USART, _txBuffer.read());
+        usart_send(MIDI_USART, data);
     }
+}
 
-    _txBuffer.write(data);
-
+void Midi::startTx() {
     // start transmission if necessary
     if (!_txActive) {
         _txActive = 1;
-        usart_wait_send_ready(MIDI_USART);
-        usart_send(MIDI_USART, _txBuffer.read());
+        sendNext();
         usart_enable_tx_interrupt(MIDI_USART);
     }
 }
@@ -82,11 +111,12 @@ void Midi::send(uint8_t data) {
 void Midi::handleIrq() {
     os::InterruptLock lock;
     if (usart_get_flag(MIDI_USART, USART_SR_TXE)) {
-        if (_txBuffer.empty()) {
+        uint8_t data;
+        if (_txQueue.read(data)) {
+            usart_send(MIDI_USART, data);
+        } else {
             usart_disable_tx_interrupt(MIDI_USART);
             _txActive = 0;
-        } else {
-            usart_send(MIDI_USART, _txBuffer.read());
         }
     }
     if (usart_get_flag(MIDI_USART, USART_SR_RXNE)) {
@@ -2,6 +2,7 @@
 
 #include "core/midi/MidiMessage.h"
 #include "core/midi/MidiParser.h"
+#include "core/midi/MidiTxQueue.h"
 #include "core/utils/RingBuffer.h"
 
 #include <functional>
@@ -11,21 +12,34 @@
 class Midi {
 public:
     typedef std::function<bool(uint8_t)> RecvFilter;
+    typedef MidiParser::SysExHandler RecvSysExHandler;
 
     void init();
 
     bool send(const MidiMessage &message);
+    // sends a real-time byte ahead of queued messages
+    bool sendRealTime(uint8_t data);
     bool recv(MidiMessage *message);
+    // receives up to count messages, returns the number of messages received
+    size_t recv(MidiMessage *messages, size_t count);
 
     void setRecvFilter(RecvFilter filter);
 
+    void setRecvSysExHandler(RecvSysExHandler handler) {
+        _midiParser.setSysExHandler(handler);
+    }
+
     uint32_t rxOverflow() const { return _rxOverflow; }
 
+    uint32_t txHighWatermark() const { return _txQueue.highWatermark(); }
+    uint32_t txBytesSaved() const { return _txQueue.bytesSaved(); }
+
     void handleIrq();
 private:
-    void send(uint8_t data);
+    void sendNext();
+    void startTx();
 
-    RingBuffer<uint8_t, 64> _txBuffer;
+    MidiTxQueue _txQueue;
     RingBuffer<uint8_t, 64> _rxBuffer;
     volatile uint32_t _rxOverflow = 0;
     volatile uint32_t _txActive = 0;
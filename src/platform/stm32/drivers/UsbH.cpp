@@ -62,12 +62,20 @@ struct MidiDriverHandler {
         switch (code) {
         case 0x0: // (1, 2 or 3 bytes) Miscellaneous function codes. Reserved for future extensions.
         case 0x1: // (1, 2 or 3 bytes) Cable events. Reserved for future expansion.
+            // ignore for now
+            return;
         case 0x4: // (3 bytes) SysEx starts or continues
-        case 0x6: // (2 bytes) SysEx ends with following two bytes.
         case 0x7: // (3 bytes) SysEx ends with following three bytes.
-            // ignore for now
+            g_usbh->midiEnqueueSysEx(device, &data[1], 3);
+            return;
+        case 0x6: // (2 bytes) SysEx ends with following two bytes.
+            g_usbh->midiEnqueueSysEx(device, &data[1], 2);
             return;
         case 0x5: // (1 bytes) Single-byte System Common Message or SysEx ends with following single byte.
+            if (data[1] == MidiMessage::EndOfExclusive) {
+                g_usbh->midiEnqueueSysEx(device, &data[1], 1);
+                return;
+            }
             message = MidiMessage(data[1]);
             g_usbh->midiEnqueueMessage(device, message);
             break;
@@ -95,7 +103,7 @@ struct MidiDriverHandler {
     static void write(uint8_t device, MidiMessage &message) {
         uint8_t data[4];
 
-        data[0] = message.status() >> 4;
+        data[0] = codeIndex(message);
         data[1] = message.status();
         data[2] = message.data0();
         data[3] = message.data1();
@@ -103,6 +111,17 @@ struct MidiDriverHandler {
         usbh_midi_write(device, data, 4, &writeCallback);
     }
 
+    static uint8_t codeIndex(const MidiMessage &message) {
+        const uint8_t *raw = message.raw();
+        int length = message.length();
+        if (length > 0 && raw[length - 1] == MidiMessage::EndOfExclusive) {
+            return 0x4 + length; // SysEx ends with following 1, 2 or 3 bytes
+        } else if (message.isSystemExclusive() || raw[0] < 0x80) {
+            return 0x4; // SysEx starts or continues
+        }
+        return message.status() >> 4;
+    }
+
     static void writeCallback(uint8_t bytes_written) {
     }
 };
@@ -35,6 +35,10 @@ private:
         _usbMidi.enqueueMessage(message);
     }
 
+    void midiEnqueueSysEx(uint8_t device, const uint8_t *data, size_t length) {
+        _usbMidi.enqueueSysEx(data, length);
+    }
+
     void midiEnqueueData(uint8_t device, uint8_t data) {
         _usbMidi.enqueueData(data);
     }
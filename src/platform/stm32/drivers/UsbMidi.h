@@ -2,7 +2,11 @@
 
 #include "core/utils/RingBuffer.h"
 #include "core/midi/MidiMessage.h"
+#include "core/midi/MidiParser.h"
 
+#include "os/os.h"
+
+#include <algorithm>
 #include <functional>
 
 #include <cstdint>
@@ -12,10 +16,12 @@ public:
     typedef std::function<void(uint16_t vendorId, uint16_t productId)> ConnectHandler;
     typedef std::function<void()> DisconnectHandler;
     typedef std::function<bool(uint8_t)> RecvFilter;
+    typedef MidiParser::SysExHandler RecvSysExHandler;
 
     void init() {}
 
     bool send(const MidiMessage &message) {
+        os::InterruptLock lock;
         if (_txQueue.full()) {
             return false;
         }
@@ -23,14 +29,52 @@ public:
         return true;
     }
 
-    bool recv(MidiMessage *message) {
-        if (_rxQueue.empty()) {
+    // sends a real-time byte ahead of queued messages
+    bool sendRealTime(uint8_t data) {
+        if (_txRealTimeQueue.full()) {
+            return false;
+        }
+        _txRealTimeQueue.write(data);
+        return true;
+    }
+
+    // queues a complete sysex message, fails if it does not fit the queue
+    // the message is queued atomically so it is not interleaved with messages queued by send()
+    bool sendSysEx(const uint8_t *data, size_t length) {
+        os::InterruptLock lock;
+        if (_txQueue.writable() < MidiMessage::sysExChunks(length)) {
             return false;
         }
-        *message = _rxQueue.read();
+        MidiMessage::splitSysEx(data, length, [this] (const MidiMessage &chunk) {
+            _txQueue.write(chunk);
+        });
         return true;
     }
 
+    bool recv(MidiMessage *message) {
+        return recv(message, 1) == 1;
+    }
+
+    // receives up to count messages, returns the number of messages received
+    size_t recv(MidiMessage *messages, size_t count) {
+        // received sysex data is passed to the sysex handler
+        uint8_t data[16];
+        while (!_rxSysExBuffer.empty()) {
+            size_t length = std::min(_rxSysExBuffer.readable(), sizeof(data));
+            _rxSysExBuffer.read(data, length);
+            _sysExParser.feed(data, length, [] (const MidiMessage &message) {});
+        }
+        if (_rxSysExOverflow) {
+            // remaining data of the message was dropped
+            _sysExParser.abortSysEx();
+            _rxSysExOverflow = false;
+        }
+
+        size_t received = std::min(_rxQueue.readable(), count);
+        _rxQueue.read(messages, received);
+        return received;
+    }
+
     void setConnectHandler(ConnectHandler handler) {
         _connectHandler = handler;
     }
@@ -43,7 +87,11 @@ public:
         _recvFilter = filter;
     }
 
-    uint32_t rxOverflow() const { return 0; }
+    void setRecvSysExHandler(RecvSysExHandler handler) {
+        _sysExParser.setSysExHandler(handler);
+    }
+
+    uint32_t rxOverflow() const { return _rxOverflow; }
 
 private:
     void connect(uint16_t vendorId, uint16_t productId) {
@@ -66,6 +114,17 @@ private:
         _rxQueue.write(message);
     }
 
+    void enqueueSysEx(const uint8_t *data, size_t length) {
+        // after an overflow, data is dropped until the receiver has aborted the message
+        if (_rxSysExOverflow || _rxSysExBuffer.writable() < length) {
+            // overflow
+            ++_rxOverflow;
+            _rxSysExOverflow = true;
+            return;
+        }
+        _rxSysExBuffer.write(data, length);
+    }
+
     void enqueueData(uint8_t data) {
         if (_recvFilter && !_recvFilter(data)) {
             // _recvFilter(data);
@@ -73,6 +132,10 @@ private:
     }
 
     bool dequeueMessage(MidiMessage *message) {
+        if (!_txRealTimeQueue.empty()) {
+            *message = MidiMessage(_txRealTimeQueue.read());
+            return true;
+        }
         if (_txQueue.empty()) {
             return false;
         }
@@ -85,8 +148,12 @@ private:
     RecvFilter _recvFilter;
 
     RingBuffer<MidiMessage, 128> _txQueue;
+    RingBuffer<uint8_t, 16> _txRealTimeQueue;
     RingBuffer<MidiMessage, 16> _rxQueue;
+    RingBuffer<uint8_t, 256> _rxSysExBuffer;
+    MidiParser _sysExParser;
     volatile uint32_t _rxOverflow = 0;
+    volatile bool _rxSysExOverflow = false;
 
     friend class UsbH;
 };
@@ -102,6 +102,7 @@ namespace os {
     namespace this_task {
 
         inline TaskHandle handle() { return xTaskGetCurrentTaskHandle(); }
+        inline const char *name() { return handle() ? pcTaskGetName(handle()) : "main"; }
 
         inline void suspend() { os::suspend(handle()); }
         inline void resume() { os::suspend(handle()); }
@@ -0,0 +1,294 @@
+#include "UnitTest.h"
+
+#include "core/gfx/Canvas.h"
+#include "core/gfx/FrameBuffer.h"
+#include "core/gfx/TextCache.h"
+
+#include "core/gfx/fonts/tiny5x5.h"
+#include "core/gfx/fonts/tiny5x5_strips.h"
+#include "core/gfx/fonts/ati8x8.h"
+#include "core/gfx/fonts/ati8x8_strips.h"
+
+#include <cstdint>
+
+// checks that the row masks of a font decode to the same pixels as its packed bitmaps
+static bool stripsMatchFont(const BitmapFont &font, const uint8_t (*strips)[8], size_t stripCount) {
+    if (stripCount != size_t(font.last - font.first + 1)) {
+        return false;
+    }
+    for (int index = 0; index <= font.last - font.first; ++index) {
+        const auto &g = font.glyphs[index];
+        int bit = 0;
+        for (int y = 0; y < g.height; ++y) {
+            for (int x = 0; x < g.width; ++x, ++bit) {
+                bool set = (font.bitmap[g.offset + (bit >> 3)] >> (bit & 7)) & 1;
+                if (set != bool((strips[index][y] >> x) & 1)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+UNIT_TEST("Canvas") {
+
+    const int Width = 16;
+    const int Height = 4;
+
+    CASE("frame buffer packs two pixels per byte") {
+        uint8_t data[Width * Height / 2] = { 0 };
+        FrameBuffer4bit frameBuffer(Width, Height, data);
+        expectEqual(frameBuffer.size(), Width * Height / 2);
+
+        frameBuffer.set(0, 0, 0x3);
+        frameBuffer.set(1, 0, 0xc);
+        frameBuffer.set(5, 1, 0xf);
+        expectEqual(int(data[0]), 0x3c, "left pixel in high nibble");
+        expectEqual(int(data[Width / 2 + 2]), 0x0f, "right pixel in low nibble");
+        expectEqual(int(frameBuffer(0, 0)), 0x3);
+        expectEqual(int(frameBuffer(1, 0)), 0xc);
+        expectEqual(int(frameBuffer(4, 1)), 0x0);
+        expectEqual(int(frameBuffer(5, 1)), 0xf);
+
+        frameBuffer.fill(0x20);
+        expectEqual(int(data[0]), 0xff, "fill saturates");
+    }
+
+    CASE("blend modes saturate") {
+        uint8_t data[Width * Height / 2] = { 0 };
+        FrameBuffer4bit frameBuffer(Width, Height, data);
+        Canvas canvas(frameBuffer);
+
+        canvas.setColor(0x8);
+        canvas.setBlendMode(BlendMode::Set);
+        canvas.hline(0, 0, 3);
+        canvas.setBlendMode(BlendMode::Add);
+        canvas.point(1, 0);
+        canvas.point(2, 0);
+        canvas.point(2, 0);
+        expectEqual(int(frameBuffer(0, 0)), 0x8);
+        expectEqual(int(frameBuffer(1, 0)), 0xf, "add saturates");
+        expectEqual(int(frameBuffer(2, 0)), 0xf, "add saturates");
+        expectEqual(int(frameBuffer(3, 0)), 0x0, "neighbour untouched");
+
+        canvas.setColor(0x9);
+        canvas.setBlendMode(BlendMode::Sub);
+        canvas.hline(0, 0, 2);
+        expectEqual(int(frameBuffer(0, 0)), 0x0, "sub saturates");
+        expectEqual(int(frameBuffer(1, 0)), 0x6);
+        expectEqual(int(frameBuffer(2, 0)), 0xf, "neighbour untouched");
+    }
+
+    CASE("drawing is clipped") {
+        uint8_t data[Width * Height / 2] = { 0 };
+        FrameBuffer4bit frameBuffer(Width, Height, data);
+        Canvas canvas(frameBuffer);
+
+        canvas.setColor(0xf);
+        canvas.fillRect(-4, -4, 5, 5);
+        canvas.fillRect(Width - 1, Height - 1, 4, 4);
+        for (int y = 0; y < Height; ++y) {
+            for (int x = 0; x < Width; ++x) {
+                bool lit = (x == 0 && y == 0) || (x == Width - 1 && y == Height - 1);
+                expectEqual(int(frameBuffer(x, y)), lit ? 0xf : 0x0);
+            }
+        }
+    }
+
+    CASE("span kernels match pixel kernels") {
+        const int SpanWidth = 64;
+        uint8_t spanData[SpanWidth / 2];
+        uint8_t pixelData[SpanWidth / 2];
+        FrameBuffer4bit spanBuffer(SpanWidth, 1, spanData);
+        FrameBuffer4bit pixelBuffer(SpanWidth, 1, pixelData);
+
+        auto reset = [&] () {
+            for (int x = 0; x < SpanWidth; ++x) {
+                spanBuffer.set(x, 0, x & 0xf);
+                pixelBuffer.set(x, 0, x & 0xf);
+            }
+        };
+
+        auto check = [&] (const char *name) {
+            for (int x = 0; x < SpanWidth; ++x) {
+                expectEqual(int(spanBuffer(x, 0)), int(pixelBuffer(x, 0)), name);
+            }
+        };
+
+        for (int x0 = 0; x0 < 4; ++x0) {
+            for (int x1 = SpanWidth - 4; x1 < SpanWidth; ++x1) {
+                for (uint8_t color : { 0x0, 0x5, 0xf, 0x20 }) {
+                    reset();
+                    blit::span<blit::set>(spanBuffer, x0, x1, 0, color);
+                    for (int x = x0; x <= x1; ++x) blit::set()(pixelBuffer, x, 0, color);
+                    check("set");
+
+                    reset();
+                    blit::span<blit::add>(spanBuffer, x0, x1, 0, color);
+                    for (int x = x0; x <= x1; ++x) blit::add()(pixelBuffer, x, 0, color);
+                    check("add");
+
+                    reset();
+                    blit::span<blit::sub>(spanBuffer, x0, x1, 0, color);
+                    for (int x = x0; x <= x1; ++x) blit::sub()(pixelBuffer, x, 0, color);
+                    check("sub");
+                }
+            }
+        }
+    }
+
+    CASE("bitmaps are clipped") {
+        uint8_t data[Width * Height / 2] = { 0 };
+        FrameBuffer4bit frameBuffer(Width, Height, data);
+        Canvas canvas(frameBuffer);
+
+        // 4x4 1bpp checkerboard
+        const uint8_t bitmap[] = { 0xa5, 0xa5 };
+        canvas.setColor(0xf);
+        canvas.drawBitmap1bit(-2, -2, 4, 4, bitmap);
+        expectEqual(int(frameBuffer(0, 0)), 0xf);
+        expectEqual(int(frameBuffer(1, 0)), 0x0);
+        expectEqual(int(frameBuffer(0, 1)), 0x0);
+        expectEqual(int(frameBuffer(1, 1)), 0xf);
+        expectEqual(int(frameBuffer(2, 0)), 0x0, "outside bitmap");
+    }
+
+    CASE("lines") {
+        uint8_t data[Width * Height / 2] = { 0 };
+        FrameBuffer4bit frameBuffer(Width, Height, data);
+        Canvas canvas(frameBuffer);
+
+        // end points are drawn with partial coverage, so start outside
+        canvas.setColor(0xf);
+        canvas.line(-1, 1, Width, 1);
+        for (int x = 0; x < Width; ++x) {
+            expectEqual(int(frameBuffer(x, 0)), 0x0, "horizontal");
+            expectEqual(int(frameBuffer(x, 1)), 0xf, "horizontal");
+        }
+
+        frameBuffer.fill(0);
+        canvas.line(3, -10, 3, 10);
+        for (int y = 0; y < Height; ++y) {
+            expectEqual(int(frameBuffer(2, y)), 0x0, "vertical");
+            expectEqual(int(frameBuffer(3, y)), 0xf, "vertical");
+        }
+    }
+
+    CASE("glyph strips match font bitmaps") {
+        expectTrue(stripsMatchFont(tiny5x5, tiny5x5_strips, sizeof(tiny5x5_strips) / sizeof(tiny5x5_strips[0])), "tiny5x5");
+        expectTrue(stripsMatchFont(ati8x8, ati8x8_strips, sizeof(ati8x8_strips) / sizeof(ati8x8_strips[0])), "ati8x8");
+    }
+
+    CASE("cached text width matches measured width") {
+        uint8_t data[64 * 16 / 2] = { 0 };
+        FrameBuffer4bit frameBuffer(64, 16, data);
+        Canvas direct(frameBuffer);
+        Canvas cached(frameBuffer);
+        TextCache textCache;
+        cached.setTextCache(&textCache);
+
+        for (auto font : { Font::Tiny, Font::Small }) {
+            direct.setFont(font);
+            cached.setFont(font);
+            for (const char *str : { "Note", "{|}", "a b", " ", "" }) {
+                cached.drawText(2, 8, str);
+                expectEqual(cached.textWidth(str), direct.textWidth(str), "width");
+            }
+        }
+    }
+
+    CASE("text cache keeps runs used every frame") {
+        TextCache textCache;
+        const char *labels[] = { "A", "B", "C", "D", "E", "F", "G", "H" };
+        const int LabelCount = sizeof(labels) / sizeof(labels[0]);
+        static_assert(LabelCount > TextCache::Size, "more labels than runs");
+
+        int hits = 0;
+        for (int frame = 0; frame < 4; ++frame) {
+            textCache.nextFrame();
+            hits = 0;
+            for (int i = 0; i < LabelCount; ++i) {
+                TextCache::Key key = { uint32_t(i), 0, labels[i] };
+                if (textCache.find(key)) {
+                    ++hits;
+                } else if (auto *run = textCache.admit(key)) {
+                    textCache.allocate(*run, key);
+                }
+            }
+            // labels are only admitted once seen before
+            if (frame == 0) {
+                expectEqual(hits, 0, "hits on first frame");
+            }
+        }
+        expectEqual(hits, int(TextCache::Size), "hits per frame");
+
+        // runs not used in the previous frame are replaced
+        for (int frame = 0; frame < 3; ++frame) {
+            textCache.nextFrame();
+            hits = 0;
+            for (int i = LabelCount - 1; i >= LabelCount - TextCache::Size; --i) {
+                TextCache::Key key = { uint32_t(i), 0, labels[i] };
+                if (textCache.find(key)) {
+                    ++hits;
+                } else if (auto *run = textCache.admit(key)) {
+                    textCache.allocate(*run, key);
+                }
+            }
+        }
+        expectEqual(hits, int(TextCache::Size), "hits after labels changed");
+    }
+
+    CASE("cached text matches direct text") {
+        const int TextWidth = 64;
+        const int TextHeight = 16;
+        uint8_t directData[TextWidth * TextHeight / 2];
+        uint8_t cachedData[TextWidth * TextHeight / 2];
+        FrameBuffer4bit directBuffer(TextWidth, TextHeight, directData);
+        FrameBuffer4bit cachedBuffer(TextWidth, TextHeight, cachedData);
+        Canvas direct(directBuffer);
+        Canvas cached(cachedBuffer);
+        TextCache textCache;
+        cached.setTextCache(&textCache);
+
+        auto reset = [&] () {
+            for (int y = 0; y < TextHeight; ++y) {
+                for (int x = 0; x < TextWidth; ++x) {
+                    directBuffer.set(x, y, (x + y) & 0xf);
+                    cachedBuffer.set(x, y, (x + y) & 0xf);
+                }
+            }
+        };
+
+        auto check = [&] () {
+            for (int y = 0; y < TextHeight; ++y) {
+                for (int x = 0; x < TextWidth; ++x) {
+                    expectEqual(int(cachedBuffer(x, y)), int(directBuffer(x, y)));
+                }
+            }
+        };
+
+        for (auto font : { Font::Tiny, Font::Small }) {
+            for (auto blendMode : { BlendMode::Set, BlendMode::Add, BlendMode::Sub }) {
+                for (int x : { 0, 1, 2, 3, 60 }) {
+                    for (const char *str : { "Note", "{|}", "a b", " ", "" }) {
+                        for (auto canvas : { &direct, &cached }) {
+                            canvas->setFont(font);
+                            canvas->setBlendMode(blendMode);
+                            canvas->setColor(0x7);
+                        }
+                        // draw on consecutive frames to see, render and then hit the run
+                        for (int i = 0; i < 3; ++i) {
+                            textCache.nextFrame();
+                            reset();
+                            direct.drawText(x, 8, str);
+                            cached.drawText(x, 8, str);
+                            check();
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+}
@@ -0,0 +1,268 @@
+#include "UnitTest.h"
+
+#include "core/midi/MidiParser.h"
+#include "core/utils/Random.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <cstdint>
+
+// collects parsed messages and reassembled sysex payloads
+struct ParserRecorder {
+    struct SysEx {
+        std::vector<uint8_t> data;
+        MidiParser::SysExStatus status;
+    };
+
+    ParserRecorder() {
+        parser.setSysExHandler([this] (const uint8_t *data, size_t length, size_t offset, MidiParser::SysExStatus status) {
+            if (offset == 0) {
+                sysEx.emplace_back();
+            }
+            auto &current = sysEx.back();
+            if (offset != current.data.size() || length > MidiParser::SysExChunkSize) {
+                chunkErrors++;
+            }
+            if (status == MidiParser::SysExContinue && length != MidiParser::SysExChunkSize) {
+                chunkErrors++;
+            }
+            current.data.insert(current.data.end(), data, data + length);
+            current.status = status;
+            chunks++;
+        });
+    }
+
+    void feed(const std::vector<uint8_t> &bytes) {
+        for (auto data : bytes) {
+            if (parser.feed(data)) {
+                messages.emplace_back(parser.message());
+            }
+        }
+    }
+
+    MidiParser parser;
+    std::vector<MidiMessage> messages;
+    std::vector<SysEx> sysEx;
+    int chunks = 0;
+    int chunkErrors = 0;
+};
+
+static bool equal(const MidiMessage &a, const MidiMessage &b) {
+    return a.length() == b.length() && std::equal(a.raw(), a.raw() + a.length(), b.raw());
+}
+
+static bool equal(const std::vector<MidiMessage> &a, const std::vector<MidiMessage> &b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [] (const MidiMessage &a, const MidiMessage &b) {
+        return equal(a, b);
+    });
+}
+
+static std::vector<uint8_t> makeSysEx(size_t length, uint8_t seed = 0) {
+    std::vector<uint8_t> bytes = { 0xf0 };
+    for (size_t i = 0; i < length; ++i) {
+        bytes.emplace_back((seed + i) & 0x7f);
+    }
+    bytes.emplace_back(0xf7);
+    return bytes;
+}
+
+UNIT_TEST("MidiParser") {
+
+    CASE("channel messages with running status") {
+        ParserRecorder recorder;
+        recorder.feed({ 0x90, 60, 100, 62, 100, 0xc1, 5, 6 });
+        expectEqual(int(recorder.messages.size()), 4, "messages");
+        expectTrue(equal(recorder.messages[1], MidiMessage::makeNoteOn(0, 62, 100)), "running status");
+        expectTrue(equal(recorder.messages[3], MidiMessage(0xc1, 6)), "program change");
+    }
+
+    CASE("sysex is delivered in chunks") {
+        ParserRecorder recorder;
+        auto sysEx = makeSysEx(40);
+        recorder.feed(sysEx);
+        expectEqual(recorder.chunks, 3, "chunks");
+        expectEqual(recorder.chunkErrors, 0, "chunk errors");
+        expectEqual(int(recorder.sysEx.size()), 1, "sysex");
+        expectTrue(recorder.sysEx[0].data == std::vector<uint8_t>(sysEx.begin() + 1, sysEx.end() - 1), "payload");
+        expectEqual(int(recorder.sysEx[0].status), int(MidiParser::SysExEnd), "status");
+    }
+
+    CASE("empty last chunk") {
+        ParserRecorder recorder;
+        recorder.feed(makeSysEx(MidiParser::SysExChunkSize));
+        expectEqual(recorder.chunks, 2, "chunks");
+        expectEqual(int(recorder.sysEx[0].data.size()), int(MidiParser::SysExChunkSize), "payload");
+        expectEqual(int(recorder.sysEx[0].status), int(MidiParser::SysExEnd), "status");
+    }
+
+    CASE("real-time bytes inside sysex") {
+        ParserRecorder recorder;
+        recorder.feed({ 0xf0, 1, 2, 0xf8, 3, 0xfa, 0xf7 });
+        expectEqual(int(recorder.messages.size()), 2, "real-time messages");
+        std::vector<uint8_t> expected = { 1, 2, 3 };
+        expectTrue(recorder.sysEx[0].data == expected, "payload");
+        expectEqual(int(recorder.sysEx[0].status), int(MidiParser::SysExEnd), "status");
+    }
+
+    CASE("sysex aborted by status byte") {
+        ParserRecorder recorder;
+        recorder.feed({ 0xf0, 1, 2, 0x90, 60, 100, 0xf0, 3, 0xf4, 4, 0xf7 });
+        expectEqual(int(recorder.sysEx.size()), 2, "sysex");
+        expectEqual(int(recorder.sysEx[0].status), int(MidiParser::SysExAborted), "aborted by channel message");
+        expectEqual(int(recorder.sysEx[1].status), int(MidiParser::SysExAborted), "aborted by undefined status");
+        expectEqual(int(recorder.messages.size()), 1, "messages");
+        expectTrue(equal(recorder.messages[0], MidiMessage::makeNoteOn(0, 60, 100)), "note on");
+    }
+
+    CASE("aborted sysex discards data until next sysex") {
+        ParserRecorder recorder;
+        recorder.feed({ 0xf0, 1, 2 });
+        recorder.parser.abortSysEx();
+        recorder.feed({ 3, 4, 0xf7, 0xf0, 5, 0xf7 });
+        expectEqual(int(recorder.sysEx.size()), 2, "sysex");
+        expectEqual(int(recorder.sysEx[0].status), int(MidiParser::SysExAborted), "aborted");
+        expectTrue(recorder.sysEx[0].data == std::vector<uint8_t>({ 1, 2 }), "aborted payload");
+        expectTrue(recorder.sysEx[1].data == std::vector<uint8_t>({ 5 }), "next payload");
+        expectEqual(int(recorder.sysEx[1].status), int(MidiParser::SysExEnd), "next status");
+        expectEqual(int(recorder.messages.size()), 0, "messages");
+    }
+
+    CASE("running status is cancelled by sysex") {
+        ParserRecorder recorder;
+        recorder.feed({ 0x90, 60, 100, 0xf0, 1, 0xf7, 62, 100 });
+        expectEqual(int(recorder.messages.size()), 1, "messages");
+    }
+
+    CASE("fuzz") {
+        Random rng(1234);
+        for (int iteration = 0; iteration < 200; ++iteration) {
+            std::vector<uint8_t> stream;
+            std::vector<MidiMessage> expectedMessages;
+            std::vector<std::vector<uint8_t>> expectedSysEx;
+
+            auto addRealTime = [&] () {
+                if (rng.nextRange(8) == 0) {
+                    uint8_t data = MidiMessage::Tick + rng.nextRange(4);
+                    stream.emplace_back(data);
+                    expectedMessages.emplace_back(data);
+                }
+            };
+
+            uint8_t runningStatus = 0;
+            for (int segment = 0; segment < 50; ++segment) {
+                if (rng.nextBinary()) {
+                    uint8_t status = (rng.nextBinary() && runningStatus) ? runningStatus : uint8_t(0x80 | (rng.nextRange(7) << 4) | rng.nextRange(16));
+                    MidiMessage message(status, rng.nextRange(128), rng.nextRange(128));
+                    int length = 1 + MidiMessage::channelMessageLength(MidiMessage::channelMessage(status));
+                    if (status != runningStatus) {
+                        stream.emplace_back(status);
+                    }
+                    for (int i = 1; i < length; ++i) {
+                        addRealTime();
+                        stream.emplace_back(message.raw()[i]);
+                    }
+                    expectedMessages.emplace_back(length == 2 ? MidiMessage(status, message.data0()) : message);
+                    runningStatus = status;
+                } else {
+                    auto sysEx = makeSysEx(rng.nextRange(100), rng.next());
+                    for (auto data : sysEx) {
+                        addRealTime();
+                        stream.emplace_back(data);
+                    }
+                    expectedSysEx.emplace_back(sysEx.begin() + 1, sysEx.end() - 1);
+                    runningStatus = 0;
+                }
+            }
+
+            ParserRecorder recorder;
+            recorder.feed(stream);
+            expectEqual(recorder.chunkErrors, 0, "chunk errors");
+            expectTrue(equal(recorder.messages, expectedMessages), "messages");
+            expectEqual(recorder.sysEx.size(), expectedSysEx.size(), "sysex count");
+            for (size_t i = 0; i < std::min(recorder.sysEx.size(), expectedSysEx.size()); ++i) {
+                expectTrue(recorder.sysEx[i].data == expectedSysEx[i], "sysex payload");
+                expectEqual(int(recorder.sysEx[i].status), int(MidiParser::SysExEnd), "sysex status");
+            }
+        }
+    }
+
+    CASE("batch feed matches byte feed") {
+        Random rng(4321);
+        std::vector<uint8_t> stream;
+        for (int i = 0; i < 10000; ++i) {
+            // mostly valid data with random status bytes
+            stream.emplace_back(rng.nextRange(8) == 0 ? 0x80 | rng.nextRange(128) : rng.nextRange(128));
+        }
+
+        ParserRecorder recorder;
+        recorder.feed(stream);
+
+        ParserRecorder batchRecorder;
+        std::vector<MidiMessage> messages;
+        size_t count = 0;
+        for (size_t offset = 0; offset < stream.size(); offset += 7) {
+            size_t length = std::min(stream.size() - offset, size_t(7));
+            count += batchRecorder.parser.feed(stream.data() + offset, length, [&] (const MidiMessage &message) {
+                messages.emplace_back(message);
+            });
+        }
+
+        expectEqual(count, messages.size(), "count");
+        expectTrue(equal(messages, recorder.messages), "messages");
+        expectEqual(batchRecorder.sysEx.size(), recorder.sysEx.size(), "sysex");
+    }
+
+    CASE("throughput") {
+        std::vector<uint8_t> stream;
+        while (stream.size() < 1024 * 1024) {
+            auto sysEx = makeSysEx(256);
+            stream.insert(stream.end(), sysEx.begin(), sysEx.end());
+        }
+
+        MidiParser parser;
+        size_t received = 0;
+        parser.setSysExHandler([&] (const uint8_t *data, size_t length, size_t offset, MidiParser::SysExStatus status) {
+            received += length;
+        });
+
+        auto start = std::chrono::steady_clock::now();
+        for (auto data : stream) {
+            parser.feed(data);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        size_t messages = stream.size() / 258;
+        expectEqual(received, messages * 256, "received");
+        double seconds = std::chrono::duration<double>(end - start).count();
+        DBG("sysex throughput %.1f MB/s", stream.size() / seconds / (1024 * 1024));
+
+        // note stream with running status
+        stream.clear();
+        stream.emplace_back(0x90);
+        while (stream.size() < 1024 * 1024) {
+            stream.emplace_back(stream.size() & 0x7f);
+        }
+
+        size_t byteMessages = 0;
+        start = std::chrono::steady_clock::now();
+        for (auto data : stream) {
+            byteMessages += parser.feed(data) ? 1 : 0;
+        }
+        end = std::chrono::steady_clock::now();
+        double byteSeconds = std::chrono::duration<double>(end - start).count();
+
+        size_t batchMessages = 0;
+        start = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset < stream.size(); offset += 64) {
+            batchMessages += parser.feed(stream.data() + offset, std::min(stream.size() - offset, size_t(64)), [] (const MidiMessage &message) {});
+        }
+        end = std::chrono::steady_clock::now();
+        double batchSeconds = std::chrono::duration<double>(end - start).count();
+
+        expectEqual(batchMessages, byteMessages, "messages");
+        DBG("message throughput %.1f MB/s (batch %.1f MB/s)", stream.size() / byteSeconds / (1024 * 1024), stream.size() / batchSeconds / (1024 * 1024));
+    }
+
+}
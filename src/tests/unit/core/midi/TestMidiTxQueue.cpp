@@ -0,0 +1,96 @@
+#include "UnitTest.h"
+
+#include "core/midi/MidiTxQueue.h"
+
+#include <vector>
+
+#include <cstdint>
+
+static std::vector<uint8_t> readAll(MidiTxQueue &queue) {
+    std::vector<uint8_t> bytes;
+    uint8_t data;
+    while (queue.read(data)) {
+        bytes.emplace_back(data);
+    }
+    return bytes;
+}
+
+UNIT_TEST("MidiTxQueue") {
+
+    CASE("real-time bytes are sent between message bytes") {
+        MidiTxQueue queue;
+        queue.write(MidiMessage::makeNoteOn(0, 60, 100));
+        uint8_t data;
+        expectTrue(queue.read(data));
+        expectEqual(data, uint8_t(0x90));
+        queue.writeRealTime(MidiMessage::Tick);
+        std::vector<uint8_t> expected = { 0xf8, 60, 100 };
+        expectTrue(readAll(queue) == expected, "bytes");
+        expectTrue(queue.empty(), "empty");
+    }
+
+    CASE("running status") {
+        MidiTxQueue queue;
+        queue.write(MidiMessage::makeNoteOn(0, 60, 100));
+        queue.write(MidiMessage::makeNoteOn(0, 62, 100));
+        queue.writeRealTime(MidiMessage::Tick);
+        queue.write(MidiMessage::makeNoteOn(1, 64, 100));
+        queue.write(MidiMessage::makeNoteOn(1, 65, 100));
+        std::vector<uint8_t> expected = { 0xf8, 0x90, 60, 100, 62, 100, 0x91, 64, 100, 65, 100 };
+        expectTrue(readAll(queue) == expected, "bytes");
+        expectEqual(queue.bytesSaved(), 2u, "bytes saved");
+
+        // status is sent again after the queue ran empty
+        queue.write(MidiMessage::makeNoteOn(1, 66, 100));
+        expected = { 0x91, 66, 100 };
+        expectTrue(readAll(queue) == expected, "bytes after idle");
+    }
+
+    CASE("system common messages cancel running status") {
+        MidiTxQueue queue;
+        queue.write(MidiMessage::makeNoteOn(0, 60, 100));
+        queue.write(MidiMessage(MidiMessage::SongSelect, 1));
+        queue.write(MidiMessage::makeNoteOn(0, 62, 100));
+        std::vector<uint8_t> expected = { 0x90, 60, 100, 0xf3, 1, 0x90, 62, 100 };
+        expectTrue(readAll(queue) == expected, "bytes");
+    }
+
+    CASE("queued control changes are coalesced") {
+        MidiTxQueue queue;
+        queue.write(MidiMessage::makeControlChange(0, 1, 10));
+        queue.write(MidiMessage::makeControlChange(0, 2, 20));
+        queue.write(MidiMessage::makeControlChange(0, 1, 11));
+        queue.write(MidiMessage::makeControlChange(1, 1, 30));
+        queue.write(MidiMessage::makeControlChange(0, 1, 12));
+        std::vector<uint8_t> expected = { 0xb0, 1, 12, 2, 20, 0xb1, 1, 30 };
+        expectTrue(readAll(queue) == expected, "bytes");
+        expectEqual(queue.bytesSaved(), 7u, "bytes saved");
+        expectEqual(queue.highWatermark(), 3u, "high watermark");
+    }
+
+    CASE("nrpn sequences are not coalesced") {
+        MidiTxQueue queue;
+        queue.write(MidiMessage::makeControlChange(0, 99, 1));
+        queue.write(MidiMessage::makeControlChange(0, 98, 2));
+        queue.write(MidiMessage::makeControlChange(0, 6, 10));
+        queue.write(MidiMessage::makeControlChange(0, 38, 11));
+        queue.write(MidiMessage::makeControlChange(0, 99, 1));
+        queue.write(MidiMessage::makeControlChange(0, 98, 3));
+        queue.write(MidiMessage::makeControlChange(0, 6, 20));
+        queue.write(MidiMessage::makeControlChange(0, 38, 21));
+        std::vector<uint8_t> expected = { 0xb0, 99, 1, 98, 2, 6, 10, 38, 11, 99, 1, 98, 3, 6, 20, 38, 21 };
+        expectTrue(readAll(queue) == expected, "bytes");
+        expectEqual(queue.bytesSaved(), 7u, "bytes saved");
+    }
+
+    CASE("control change being sent is not modified") {
+        MidiTxQueue queue;
+        queue.write(MidiMessage::makeControlChange(0, 1, 10));
+        uint8_t data;
+        queue.read(data);
+        queue.write(MidiMessage::makeControlChange(0, 1, 11));
+        std::vector<uint8_t> expected = { 1, 10, 1, 11 };
+        expectTrue(readAll(queue) == expected, "bytes");
+    }
+
+}
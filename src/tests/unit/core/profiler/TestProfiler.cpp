@@ -0,0 +1,80 @@
+#include "UnitTest.h"
+
+#include "core/profiler/Profiler.h"
+
+#include <string>
+
+#include <cstring>
+
+PROFILER_INTERVAL(outer, "outer")
+PROFILER_INTERVAL(inner, "inner")
+PROFILER_COUNTER(events, "events")
+
+static std::string chromeTrace() {
+    std::string trace;
+    Profiler::writeChromeTrace([&trace] (const char *str) {
+        trace += str;
+    });
+    return trace;
+}
+
+static int countOf(const std::string &str, const std::string &pattern) {
+    int count = 0;
+    for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+UNIT_TEST("Profiler") {
+
+    CASE("nothing recorded when disabled") {
+        Profiler::clear();
+        Profiler::setEnabled(false);
+        PROFILER_INTERVAL_BEGIN(outer);
+        PROFILER_INTERVAL_END(outer);
+        expectEqual(countOf(chromeTrace(), "\"ph\":\"B\""), 0);
+    }
+
+    CASE("chrome trace") {
+        Profiler::clear();
+        Profiler::setEnabled(true);
+        for (int i = 0; i < 3; ++i) {
+            PROFILER_INTERVAL_SCOPE(outer);
+            for (int j = 0; j < 2; ++j) {
+                PROFILER_INTERVAL_SCOPE(inner, j);
+                PROFILER_COUNTER_ADD(events, 1);
+            }
+        }
+        Profiler::setEnabled(false);
+
+        auto trace = chromeTrace();
+        expectTrue(trace.compare(0, 15, "{\"traceEvents\":") == 0, "header");
+        expectEqual(countOf(trace, "\"name\":\"thread_name\""), 1, "thread names");
+        expectEqual(countOf(trace, "{\"name\":\"outer\",\"ph\":\"B\""), 3, "outer begin");
+        expectEqual(countOf(trace, "{\"name\":\"outer\",\"ph\":\"E\""), 3, "outer end");
+        expectEqual(countOf(trace, "{\"name\":\"inner\",\"ph\":\"B\""), 6, "inner begin");
+        expectEqual(countOf(trace, "{\"name\":\"inner\",\"ph\":\"E\""), 6, "inner end");
+        expectEqual(countOf(trace, "\"args\":{\"arg\":1}"), 3, "inner argument");
+        expectEqual(countOf(trace, "{\"name\":\"events\",\"ph\":\"C\""), 6, "counter");
+        expectTrue(trace.find("\"args\":{\"value\":6}") != std::string::npos, "counter value");
+    }
+
+    CASE("ring buffer keeps latest events") {
+        Profiler::clear();
+        Profiler::setEnabled(true);
+        PROFILER_INTERVAL_BEGIN(outer);
+        for (int i = 0; i < CONFIG_PROFILER_EVENT_COUNT; ++i) {
+            PROFILER_INTERVAL_BEGIN(inner);
+            PROFILER_INTERVAL_END(inner);
+        }
+        PROFILER_INTERVAL_END(outer);
+        Profiler::setEnabled(false);
+
+        // begin of outer interval is overwritten, its end event is dropped
+        auto trace = chromeTrace();
+        expectEqual(countOf(trace, "\"ph\":\"B\""), CONFIG_PROFILER_EVENT_COUNT / 2 - 1, "begin events");
+        expectEqual(countOf(trace, "\"ph\":\"E\""), CONFIG_PROFILER_EVENT_COUNT / 2 - 1, "end events");
+    }
+
+}
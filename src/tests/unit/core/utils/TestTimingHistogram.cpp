@@ -0,0 +1,67 @@
+#include "UnitTest.h"
+
+#include "core/utils/TimingHistogram.h"
+
+#include <cstdint>
+
+UNIT_TEST("TimingHistogram") {
+
+    CASE("initially empty") {
+        TimingHistogram histogram;
+        expectEqual(histogram.count(), 0u);
+        expectEqual(histogram.mean(), 0u);
+        for (int i = 0; i < TimingHistogram::BucketCount; ++i) {
+            expectEqual(histogram.bucket(i), 0u);
+        }
+    }
+
+    CASE("bucket index") {
+        expectEqual(TimingHistogram::bucketIndex(0), 0);
+        expectEqual(TimingHistogram::bucketIndex(9), 0);
+        expectEqual(TimingHistogram::bucketIndex(10), 1);
+        expectEqual(TimingHistogram::bucketIndex(-10), 1);
+        expectEqual(TimingHistogram::bucketIndex(99), 2);
+        expectEqual(TimingHistogram::bucketIndex(999), 5);
+        expectEqual(TimingHistogram::bucketIndex(1000), 6);
+        expectEqual(TimingHistogram::bucketIndex(2000), 7);
+        expectEqual(TimingHistogram::bucketIndex(-1000000), 7);
+    }
+
+    CASE("record") {
+        TimingHistogram histogram;
+        histogram.record(5);
+        histogram.record(-20);
+        histogram.record(20);
+        histogram.record(3000);
+        expectEqual(histogram.count(), 4u);
+        expectEqual(histogram.bucket(0), 1u);
+        expectEqual(histogram.bucket(1), 2u);
+        expectEqual(histogram.bucket(7), 1u);
+        expectEqual(histogram.min(), -20);
+        expectEqual(histogram.max(), 3000);
+        expectEqual(histogram.mean(), 761u);
+    }
+
+    CASE("percentile limit") {
+        TimingHistogram histogram;
+        for (int i = 0; i < 99; ++i) {
+            histogram.record(1);
+        }
+        histogram.record(300);
+        expectEqual(histogram.percentileLimit(0.5f), 10u);
+        expectEqual(histogram.percentileLimit(0.99f), 10u);
+        expectEqual(histogram.percentileLimit(1.f), 500u);
+        histogram.record(5000);
+        expectEqual(histogram.percentileLimit(1.f), uint32_t(-1));
+    }
+
+    CASE("reset") {
+        TimingHistogram histogram;
+        histogram.record(100);
+        histogram.reset();
+        expectEqual(histogram.count(), 0u);
+        expectEqual(histogram.bucket(3), 0u);
+        expectEqual(histogram.max(), 0);
+    }
+
+}
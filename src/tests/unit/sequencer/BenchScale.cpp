@@ -0,0 +1,98 @@
+#include "UnitTest.h"
+
+#include "apps/sequencer/model/Scale.cpp"
+#include "apps/sequencer/model/UserScale.cpp"
+
+#include <chrono>
+#include <vector>
+
+#include <cstdint>
+
+// gives access to the table-free conversion for comparison
+struct ScaleAccess : public Scale {
+    static float calc(const Scale &scale, int note) {
+        return (scale.*(&ScaleAccess::calcNoteToVolts))(note);
+    }
+};
+
+template<typename Func>
+static double measureNs(int iterations, Func func) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        func(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+static volatile float voltsSink;
+static volatile int noteSink;
+
+UNIT_TEST("BenchScale") {
+
+    CASE("noteToVolts matches table-free conversion") {
+        for (int i = 0; i < Scale::BuiltinCount; ++i) {
+            const auto &scale = Scale::get(i);
+            for (int note = Scale::LookupMin - 16; note <= Scale::LookupMax + 16; ++note) {
+                expectEqual(scale.noteToVolts(note), ScaleAccess::calc(scale, note), "noteToVolts");
+            }
+        }
+    }
+
+    CASE("noteFromVolts matches table-free conversion") {
+        for (int i = 0; i < Scale::BuiltinCount; ++i) {
+            const auto &scale = Scale::get(i);
+            if (!dynamic_cast<const NoteScale *>(&scale)) {
+                continue;
+            }
+            // rebuild the scale without a lookup table
+            int noteCount = scale.notesPerOctave();
+            std::vector<uint16_t> notes(noteCount);
+            for (int index = 0; index < noteCount; ++index) {
+                notes[index] = uint16_t(std::round(scale.noteToVolts(index) * 1536.f));
+            }
+            NoteScale reference("", scale.isChromatic(), noteCount, notes.data(), nullptr);
+            for (int index = -6000; index < 6000; ++index) {
+                float volts = index * 0.001f;
+                expectEqual(scale.noteFromVolts(volts), reference.noteFromVolts(volts), "noteFromVolts");
+            }
+        }
+    }
+
+    CASE("user scale lookup follows edits") {
+        UserScale userScale;
+        userScale.setMode(UserScale::Mode::Voltage);
+        userScale.setSize(4);
+        userScale.setItem(0, 0);
+        userScale.setItem(1, 250);
+        userScale.setItem(2, 600);
+        userScale.setItem(3, 1500);
+        for (int note = Scale::LookupMin; note <= Scale::LookupMax; ++note) {
+            expectEqual(userScale.noteToVolts(note), ScaleAccess::calc(userScale, note), "noteToVolts");
+            expectEqual(userScale.noteFromVolts(userScale.noteToVolts(note) + 0.0005f), note, "noteFromVolts");
+        }
+
+        UserScale copy(userScale);
+        userScale.setItem(1, 300);
+        expectEqual(copy.noteToVolts(1), 0.25f, "copy keeps its own table");
+        expectEqual(userScale.noteToVolts(1), 0.3f, "table rebuilt on edit");
+    }
+
+    CASE("benchmark") {
+        const int iterations = 1000000;
+        for (int i = 0; i < Scale::BuiltinCount; ++i) {
+            const auto &scale = Scale::get(i);
+            double lookupNs = measureNs(iterations, [&] (int i) {
+                voltsSink = scale.noteToVolts(Scale::LookupMin + (i & (Scale::LookupSize - 1)));
+            });
+            double calcNs = measureNs(iterations, [&] (int i) {
+                voltsSink = ScaleAccess::calc(scale, Scale::LookupMin + (i & (Scale::LookupSize - 1)));
+            });
+            double fromVoltsNs = measureNs(iterations, [&] (int i) {
+                noteSink = scale.noteFromVolts((i % 10000) * 0.001f - 5.f);
+            });
+            DBG("%-20s noteToVolts %6.2f ns (calc %6.2f ns) noteFromVolts %6.2f ns", Scale::name(i), lookupNs, calcNs, fromVoltsNs);
+        }
+    }
+
+}
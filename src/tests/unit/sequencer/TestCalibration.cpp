@@ -0,0 +1,71 @@
+#include "UnitTest.h"
+
+#include "apps/sequencer/model/Calibration.cpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+
+// floating point interpolation between calibration items
+static float referenceVoltsToValue(const Calibration::CvOutput &cvOutput, float volts) {
+    typedef Calibration::CvOutput CvOutput;
+    volts = clamp(volts, float(CvOutput::MinVoltage), float(CvOutput::MaxVoltage));
+    float fIndex = (volts - CvOutput::MinVoltage) * CvOutput::ItemsPerVolt;
+    int index = std::floor(fIndex);
+    if (index < CvOutput::ItemCount - 1) {
+        float t = fIndex - index;
+        return lerp(t, float(cvOutput.item(index)), float(cvOutput.item(index + 1)));
+    } else {
+        return cvOutput.item(CvOutput::ItemCount - 1);
+    }
+}
+
+static void expectReference(const Calibration::CvOutput &cvOutput) {
+    for (int i = -6000; i <= 6000; ++i) {
+        float volts = i * 0.001f;
+        float reference = referenceVoltsToValue(cvOutput, volts);
+        int value = cvOutput.voltsToValue(volts);
+        expectTrue(std::abs(value - reference) <= 1.f, "voltsToValue");
+    }
+}
+
+UNIT_TEST("Calibration") {
+
+    CASE("default calibration") {
+        Calibration calibration;
+        calibration.clear();
+        for (int i = 0; i < CONFIG_CV_OUTPUT_CHANNELS; ++i) {
+            expectReference(calibration.cvOutput(i));
+        }
+    }
+
+    CASE("user defined items") {
+        Calibration calibration;
+        calibration.clear();
+        auto &cvOutput = calibration.cvOutput(0);
+        cvOutput.setUserDefined(2, true);
+        cvOutput.setItem(2, 20000);
+        cvOutput.setUserDefined(7, true);
+        cvOutput.setItem(7, 9000);
+        expectReference(cvOutput);
+        expectEqual(int(cvOutput.voltsToValue(-3.f)), 20000, "item value");
+        expectEqual(int(cvOutput.voltsToValue(2.f)), 9000, "item value");
+    }
+
+    CASE("batch conversion") {
+        Calibration calibration;
+        calibration.clear();
+        calibration.cvOutput(3).setUserDefined(5, true);
+        calibration.cvOutput(3).setItem(5, 12345);
+        std::array<float, CONFIG_CV_OUTPUT_CHANNELS> volts;
+        std::array<uint16_t, CONFIG_CV_OUTPUT_CHANNELS> values;
+        for (int i = 0; i < CONFIG_CV_OUTPUT_CHANNELS; ++i) {
+            volts[i] = -7.f + i * 2.f;
+        }
+        calibration.cvOutputVoltsToValues(volts, values);
+        for (int i = 0; i < CONFIG_CV_OUTPUT_CHANNELS; ++i) {
+            expectEqual(int(values[i]), int(calibration.cvOutput(i).voltsToValue(volts[i])), "batch value");
+        }
+    }
+
+}
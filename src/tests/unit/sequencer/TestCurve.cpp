@@ -22,8 +22,8 @@ UNIT_TEST("Curve") {
     CASE("markdown") {
 
         auto drawCurve = [] (int index, const char *filename) {
-            uint8_t data[Width * Height];
-            FrameBuffer8bit framebuffer(Width, Height, data);
+            uint8_t data[Width * Height / 2];
+            FrameBuffer4bit framebuffer(Width, Height, data);
             Canvas canvas(framebuffer);
 
             canvas.setBlendMode(BlendMode::Set);
@@ -54,11 +54,15 @@ UNIT_TEST("Curve") {
                 );
             }
 
-            for (int i = 0; i < Width * Height; ++i) {
-                data[i] = std::min(255, int(data[i]) * 0xf);
+            // unpack to 8bpp
+            uint8_t image[Width * Height];
+            for (int y = 0; y < Height; ++y) {
+                for (int x = 0; x < Width; ++x) {
+                    image[y * Width + x] = framebuffer.get(x, y) * 0x11;
+                }
             }
 
-            stbi_write_png(filename, Width, Height, 1, data, Width * 1);
+            stbi_write_png(filename, Width, Height, 1, image, Width * 1);
         };
 
         FixedStringBuilder<4096> indices("| Index |");
@@ -0,0 +1,98 @@
+#include "UnitTest.h"
+
+#include "apps/sequencer/engine/EventQueue.h"
+
+#include <cstdint>
+
+struct Event {
+    uint32_t tick;
+    int id;
+};
+
+struct EventCompare {
+    bool operator()(const Event &a, const Event &b) {
+        return a.tick < b.tick;
+    }
+};
+
+typedef EventQueue<Event, 8, EventCompare> Queue;
+
+UNIT_TEST("EventQueue") {
+
+    CASE("empty") {
+        Queue queue;
+        expectTrue(queue.empty());
+        expectEqual(queue.size(), size_t(0));
+        expectEqual(queue.capacity(), size_t(8));
+    }
+
+    CASE("ordered by tick") {
+        Queue queue;
+        uint32_t ticks[] = { 5, 3, 7, 1, 6, 2, 4, 0 };
+        for (auto tick : ticks) {
+            queue.push({ tick, 0 });
+        }
+        expectTrue(queue.full());
+        for (uint32_t tick = 0; tick < 8; ++tick) {
+            expectEqual(queue.front().tick, tick);
+            queue.pop();
+        }
+        expectTrue(queue.empty());
+    }
+
+    CASE("equal ticks in insertion order") {
+        Queue queue;
+        queue.push({ 2, 0 });
+        queue.push({ 1, 1 });
+        queue.push({ 2, 2 });
+        queue.push({ 1, 3 });
+        queue.push({ 2, 4 });
+        int ids[] = { 1, 3, 0, 2, 4 };
+        for (auto id : ids) {
+            expectEqual(queue.front().id, id);
+            queue.pop();
+        }
+    }
+
+    CASE("push replace") {
+        Queue queue;
+        queue.push({ 1, 0 });
+        queue.push({ 4, 1 });
+        queue.push({ 6, 2 });
+        queue.push({ 3, 3 });
+        queue.pushReplace({ 3, 4 });
+        expectEqual(queue.size(), size_t(3));
+        int ids[] = { 0, 3, 4 };
+        for (auto id : ids) {
+            expectEqual(queue.front().id, id);
+            queue.pop();
+        }
+    }
+
+    CASE("overflow drops latest") {
+        Queue queue;
+        for (int i = 0; i < 8; ++i) {
+            queue.push({ uint32_t(10 + i), i });
+        }
+        expectEqual(queue.overflows(), uint32_t(0));
+        queue.push({ 20, 8 });
+        expectEqual(queue.overflows(), uint32_t(1));
+        queue.push({ 0, 9 });
+        expectEqual(queue.overflows(), uint32_t(2));
+        expectEqual(queue.size(), size_t(8));
+        int ids[] = { 9, 0, 1, 2, 3, 4, 5, 6 };
+        for (auto id : ids) {
+            expectEqual(queue.front().id, id);
+            queue.pop();
+        }
+        expectTrue(queue.empty());
+    }
+
+    CASE("clear") {
+        Queue queue;
+        queue.push({ 1, 0 });
+        queue.clear();
+        expectTrue(queue.empty());
+    }
+
+}
@@ -0,0 +1,129 @@
+#include "UnitTest.h"
+
+#include "apps/sequencer/model/FileTaskQueue.cpp"
+
+#include <string>
+#include <vector>
+
+// adds a task that logs its execution and result delivery
+static FileTaskQueue::TaskId addTask(FileTaskQueue &queue, std::vector<std::string> &log, const std::string &name, FileTaskQueue::Priority priority = FileTaskQueue::Priority::Normal) {
+    return queue.add([&log, name] () {
+        log.emplace_back("execute " + name);
+        return fs::OK;
+    }, [&log, name] (fs::Error result) {
+        log.emplace_back("result " + name);
+    }, priority);
+}
+
+static void executeAll(FileTaskQueue &queue) {
+    while (queue.executeNext()) {}
+}
+
+UNIT_TEST("FileTaskQueue") {
+
+    CASE("tasks are executed in order of priority") {
+        FileTaskQueue queue;
+        std::vector<std::string> log;
+        addTask(queue, log, "low", FileTaskQueue::Priority::Low);
+        addTask(queue, log, "normal", FileTaskQueue::Priority::Normal);
+        addTask(queue, log, "high", FileTaskQueue::Priority::High);
+        executeAll(queue);
+        queue.deliverResults();
+        std::vector<std::string> expected = {
+            "execute high", "execute normal", "execute low",
+            "result high", "result normal", "result low"
+        };
+        expectTrue(log == expected, "log");
+        expectEqual(queue.pending(), 0, "pending");
+    }
+
+    CASE("tasks of same priority are executed in order of submission") {
+        FileTaskQueue queue;
+        std::vector<std::string> log;
+        addTask(queue, log, "a");
+        addTask(queue, log, "b");
+        addTask(queue, log, "c");
+        expectTrue(queue.executeNext(), "execute");
+        // a freed slot is reused but the task keeps its place in the queue
+        queue.deliverResults();
+        addTask(queue, log, "d");
+        executeAll(queue);
+        queue.deliverResults();
+        std::vector<std::string> expected = {
+            "execute a", "result a",
+            "execute b", "execute c", "execute d",
+            "result b", "result c", "result d"
+        };
+        expectTrue(log == expected, "log");
+    }
+
+    CASE("cancelled tasks are not executed") {
+        FileTaskQueue queue;
+        std::vector<std::string> log;
+        addTask(queue, log, "a");
+        auto id = addTask(queue, log, "b");
+        addTask(queue, log, "c");
+        expectEqual(queue.pending(), 3, "pending");
+        expectTrue(queue.cancel(id), "cancel");
+        expectFalse(queue.cancel(id), "cancel twice");
+        expectEqual(queue.pending(), 2, "pending after cancel");
+        executeAll(queue);
+        // executed tasks can no longer be cancelled
+        expectFalse(queue.cancel(1), "cancel executed");
+        queue.deliverResults();
+        std::vector<std::string> expected = { "execute a", "execute c", "result a", "result c" };
+        expectTrue(log == expected, "log");
+    }
+
+    CASE("queue full") {
+        FileTaskQueue queue;
+        std::vector<std::string> log;
+        for (int i = 0; i < FileTaskQueue::Size; ++i) {
+            expectTrue(addTask(queue, log, std::to_string(i)) != 0, "add");
+        }
+        expectEqual(addTask(queue, log, "full"), FileTaskQueue::TaskId(0), "add to full queue");
+        // tasks occupy their slot until the result is delivered
+        executeAll(queue);
+        expectEqual(addTask(queue, log, "full"), FileTaskQueue::TaskId(0), "add before results are delivered");
+        queue.deliverResults();
+        expectEqual(queue.pending(), 0, "pending");
+        expectTrue(addTask(queue, log, "free") != 0, "add after results are delivered");
+    }
+
+    CASE("progress") {
+        FileTaskQueue queue;
+        float progressDuringTask = -1.f;
+        expectEqual(queue.progress(), -1.f, "progress before task");
+        queue.add([&] () {
+            queue.setProgress(0.5f);
+            progressDuringTask = queue.progress();
+            return fs::OK;
+        }, [] (fs::Error result) {});
+        queue.add([&] () {
+            progressDuringTask = queue.progress();
+            return fs::OK;
+        }, [] (fs::Error result) {});
+        expectTrue(queue.executeNext(), "execute");
+        expectEqual(progressDuringTask, 0.5f, "progress during task");
+        expectEqual(queue.progress(), -1.f, "progress after task");
+        expectTrue(queue.executeNext(), "execute");
+        expectEqual(progressDuringTask, -1.f, "progress is reset for next task");
+        queue.deliverResults();
+    }
+
+    CASE("result callbacks can add tasks") {
+        FileTaskQueue queue;
+        std::vector<std::string> log;
+        queue.add([] () { return fs::OK; }, [&] (fs::Error result) {
+            addTask(queue, log, "chained");
+        });
+        executeAll(queue);
+        queue.deliverResults();
+        expectEqual(queue.pending(), 1, "pending");
+        executeAll(queue);
+        queue.deliverResults();
+        std::vector<std::string> expected = { "execute chained", "result chained" };
+        expectTrue(log == expected, "log");
+    }
+
+}
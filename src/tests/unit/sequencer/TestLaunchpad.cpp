@@ -0,0 +1,131 @@
+#include "UnitTest.h"
+
+#include "apps/sequencer/ui/controllers/launchpad/LaunchpadDevice.cpp"
+#include "apps/sequencer/ui/controllers/launchpad/LaunchpadMk2Device.cpp"
+#include "apps/sequencer/ui/controllers/launchpad/LaunchpadProDevice.cpp"
+
+#include <vector>
+
+#include <cstdint>
+
+// usb midi event packets are 4 bytes and carry up to 3 bytes of midi data
+static constexpr int PacketSize = 4;
+
+struct FrameBytes {
+    int initial;
+    int unchanged;
+    int single;
+    int row;
+    int full;
+    int clear;
+};
+
+// syncs a sequence of typical frames and returns the usb midi bytes sent per frame
+template<typename Device>
+static FrameBytes measureFrames() {
+    Device device;
+    int bytes = 0;
+    std::vector<uint8_t> sysEx;
+
+    device.setSendMidiHandler([&] (const MidiMessage &message) {
+        bytes += PacketSize;
+        return true;
+    });
+    device.setSendSysExHandler([&] (const uint8_t *data, size_t length) {
+        bytes += MidiMessage::sysExChunks(length) * PacketSize;
+        sysEx.assign(data, data + length);
+        return true;
+    });
+
+    auto fill = [&] (int red, int green) {
+        for (int row = 0; row < LaunchpadDevice::Rows + LaunchpadDevice::ExtraRows; ++row) {
+            for (int col = 0; col < LaunchpadDevice::Cols; ++col) {
+                device.setLed(row, col, red, green);
+            }
+        }
+    };
+
+    auto sync = [&] () {
+        bytes = 0;
+        device.syncLeds();
+        return bytes;
+    };
+
+    FrameBytes result;
+
+    fill(1, 1);
+    result.initial = sync();
+    result.unchanged = sync();
+
+    device.setLed(3, 4, 3, 0);
+    result.single = sync();
+
+    for (int col = 0; col < LaunchpadDevice::Cols; ++col) {
+        device.setLed(5, col, 0, 3);
+    }
+    result.row = sync();
+
+    fill(2, 2);
+    result.full = sync();
+
+    device.clearLeds();
+    result.clear = sync();
+
+    expectTrue(sysEx.empty() || (sysEx.front() == 0xf0 && sysEx.back() == 0xf7), "sysex framing");
+
+    return result;
+}
+
+UNIT_TEST("Launchpad") {
+
+    const int LedCount = LaunchpadDevice::ButtonCount;
+
+    CASE("launchpad s sends one message per changed led") {
+        auto frame = measureFrames<LaunchpadDevice>();
+        expectEqual(frame.initial, LedCount * PacketSize, "initial");
+        expectEqual(frame.unchanged, 0, "unchanged");
+        expectEqual(frame.single, PacketSize, "single");
+        expectEqual(frame.row, 8 * PacketSize, "row");
+        expectEqual(frame.full, LedCount * PacketSize, "full");
+        expectEqual(frame.clear, LedCount * PacketSize, "clear");
+    }
+
+    CASE("launchpad mk2 sends bulk updates as sysex") {
+        // header (5) + device id + command + 2 bytes per led + end of exclusive
+        const int bulkBytes = MidiMessage::sysExChunks(5 + 2 + LedCount * 2 + 1) * PacketSize;
+        auto frame = measureFrames<LaunchpadMk2Device>();
+        expectEqual(frame.initial, bulkBytes, "initial");
+        expectEqual(frame.unchanged, 0, "unchanged");
+        expectEqual(frame.single, PacketSize, "single");
+        expectEqual(frame.row, 8 * PacketSize, "row");
+        expectEqual(frame.full, bulkBytes, "full");
+        expectEqual(frame.clear, bulkBytes, "clear");
+        expectTrue(bulkBytes < LedCount * PacketSize, "bulk is smaller");
+    }
+
+    CASE("launchpad pro sends bulk updates as sysex") {
+        const int bulkBytes = MidiMessage::sysExChunks(5 + 2 + LedCount * 2 + 1) * PacketSize;
+        auto frame = measureFrames<LaunchpadProDevice>();
+        expectEqual(frame.initial, bulkBytes, "initial");
+        expectEqual(frame.unchanged, 0, "unchanged");
+        expectEqual(frame.single, PacketSize, "single");
+        expectEqual(frame.row, 8 * PacketSize, "row");
+        expectEqual(frame.full, bulkBytes, "full");
+        expectEqual(frame.clear, bulkBytes, "clear");
+    }
+
+    CASE("sysex falls back to messages if it cannot be sent") {
+        LaunchpadMk2Device device;
+        int messages = 0;
+        device.setSendMidiHandler([&] (const MidiMessage &message) {
+            ++messages;
+            return true;
+        });
+        device.setSendSysExHandler([] (const uint8_t *data, size_t length) {
+            return false;
+        });
+        device.syncLeds();
+        expectEqual(messages, LedCount, "messages");
+    }
+
+}
@@ -11,7 +11,7 @@
 UNIT_TEST("Scale") {
 
     CASE("noteName/noteToVolts") {
-        for (int i = 0; i < Scale::Count; ++i) {
+        for (int i = 0; i < Scale::BuiltinCount; ++i) {
             const auto &scale = Scale::get(i);
             int notesPerOctave = scale.notesPerOctave();
 
@@ -36,7 +36,7 @@ UNIT_TEST("Scale") {
     }
 
     CASE("noteFromVolts") {
-        for (int i = 0; i < Scale::Count; ++i) {
+        for (int i = 0; i < Scale::BuiltinCount; ++i) {
             const auto &scale = Scale::get(i);
             int notesPerOctave = scale.notesPerOctave();
 
@@ -66,7 +66,7 @@ UNIT_TEST("Scale") {
 
     CASE("markdown") {
         DBG("----------------------------------------");
-        for (int i = 0; i < Scale::Count - 4; ++i) {
+        for (int i = 0; i < Scale::BuiltinCount; ++i) {
             const auto &scale = Scale::get(i);
             int notesPerOctave = scale.notesPerOctave();
 
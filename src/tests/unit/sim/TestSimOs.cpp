@@ -0,0 +1,257 @@
+#include "UnitTest.h"
+
+#include "os/os.h"
+#include "sim/Simulator.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+// runs a simulator with threaded tasks set up by the given function
+class TaskRunner {
+public:
+    typedef std::function<void(std::vector<std::unique_ptr<os::Task<1024>>> &)> Setup;
+
+    TaskRunner(Setup setup) :
+        _simulator(sim::Target {
+            [this, setup] () { setup(_tasks); },
+            [this] () { _tasks.clear(); },
+            [] () {}
+        })
+    {
+        _simulator.setThreadedTasks(true);
+    }
+
+    void wait(int ms) { _simulator.wait(ms); }
+
+private:
+    std::vector<std::unique_ptr<os::Task<1024>>> _tasks;
+    sim::Simulator _simulator;
+};
+
+static os::Task<1024> *createTask(const char *name, uint8_t priority, std::function<void()> func) {
+    return new os::Task<1024>(name, priority, func);
+}
+
+UNIT_TEST("SimOs") {
+
+    CASE("tasks run in priority order") {
+        std::vector<std::string> log;
+        TaskRunner runner([&] (std::vector<std::unique_ptr<os::Task<1024>>> &tasks) {
+            tasks.emplace_back(createTask("low", 1, [&] () {
+                while (true) {
+                    log.emplace_back("low " + std::to_string(os::ticks()));
+                    os::delay(1);
+                }
+            }));
+            tasks.emplace_back(createTask("high", 2, [&] () {
+                while (true) {
+                    log.emplace_back("high " + std::to_string(os::ticks()));
+                    os::delay(1);
+                }
+            }));
+        });
+        runner.wait(3);
+        std::vector<std::string> expected = { "high 0", "low 0", "high 1", "low 1", "high 2", "low 2" };
+        expectTrue(log == expected, "log");
+    }
+
+    CASE("delayUntil keeps the interval") {
+        std::vector<uint32_t> wakeups;
+        TaskRunner runner([&] (std::vector<std::unique_ptr<os::Task<1024>>> &tasks) {
+            tasks.emplace_back(createTask("periodic", 1, [&] () {
+                uint32_t lastWakeupTime = os::ticks();
+                while (true) {
+                    wakeups.emplace_back(os::ticks());
+                    os::delayUntil(lastWakeupTime, os::time::ms(10));
+                }
+            }));
+        });
+        runner.wait(35);
+        std::vector<uint32_t> expected = { 0, 10, 20, 30 };
+        expectTrue(wakeups == expected, "wakeups");
+    }
+
+    CASE("queue receive blocks and sending preempts") {
+        std::vector<std::string> log;
+        os::Queue<int, 2> queue;
+        TaskRunner runner([&] (std::vector<std::unique_ptr<os::Task<1024>>> &tasks) {
+            tasks.emplace_back(createTask("producer", 1, [&] () {
+                for (int i = 0; i < 3; ++i) {
+                    log.emplace_back("send " + std::to_string(i));
+                    queue.send(i);
+                }
+                os::this_task::suspend();
+            }));
+            tasks.emplace_back(createTask("consumer", 2, [&] () {
+                while (true) {
+                    log.emplace_back("recv " + std::to_string(queue.receive()));
+                }
+            }));
+        });
+        runner.wait(1);
+        std::vector<std::string> expected = { "send 0", "recv 0", "send 1", "recv 1", "send 2", "recv 2" };
+        expectTrue(log == expected, "log");
+    }
+
+    CASE("queue send blocks when full") {
+        std::vector<std::string> log;
+        os::Queue<int, 2> queue;
+        TaskRunner runner([&] (std::vector<std::unique_ptr<os::Task<1024>>> &tasks) {
+            tasks.emplace_back(createTask("producer", 2, [&] () {
+                for (int i = 0; i < 4; ++i) {
+                    queue.sendToBack(i);
+                    log.emplace_back("send " + std::to_string(i));
+                }
+                os::this_task::suspend();
+            }));
+            tasks.emplace_back(createTask("consumer", 1, [&] () {
+                while (true) {
+                    int value;
+                    if (queue.receive(&value, 0)) {
+                        log.emplace_back("recv " + std::to_string(value));
+                    }
+                    os::delay(1);
+                }
+            }));
+        });
+        runner.wait(4);
+        std::vector<std::string> expected = { "send 0", "send 1", "send 2", "recv 0", "send 3", "recv 1", "recv 2", "recv 3" };
+        expectTrue(log == expected, "log");
+    }
+
+    CASE("semaphore take times out") {
+        std::vector<std::string> log;
+        os::Semaphore semaphore;
+        TaskRunner runner([&] (std::vector<std::unique_ptr<os::Task<1024>>> &tasks) {
+            tasks.emplace_back(createTask("waiter", 1, [&] () {
+                bool taken = semaphore.take(os::time::ms(5));
+                log.emplace_back((taken ? "taken " : "timeout ") + std::to_string(os::ticks()));
+                taken = semaphore.take(os::time::ms(5));
+                log.emplace_back((taken ? "taken " : "timeout ") + std::to_string(os::ticks()));
+                os::this_task::suspend();
+            }));
+            tasks.emplace_back(createTask("giver", 0, [&] () {
+                os::delay(7);
+                semaphore.give();
+                os::this_task::suspend();
+            }));
+        });
+        runner.wait(20);
+        std::vector<std::string> expected = { "timeout 5", "taken 7" };
+        expectTrue(log == expected, "log");
+    }
+
+    CASE("counting semaphore") {
+        os::CountingSemaphore semaphore(2, 1);
+        expectTrue(semaphore.take(0), "take");
+        expectFalse(semaphore.take(0), "take empty");
+        expectTrue(semaphore.give(), "give");
+        expectTrue(semaphore.give(), "give");
+        expectFalse(semaphore.give(), "give full");
+    }
+
+    CASE("mutex blocks higher priority task until released") {
+        std::vector<std::string> log;
+        os::Mutex mutex;
+        TaskRunner runner([&] (std::vector<std::unique_ptr<os::Task<1024>>> &tasks) {
+            tasks.emplace_back(createTask("low", 1, [&] () {
+                mutex.take();
+                log.emplace_back("low locked " + std::to_string(os::ticks()));
+                os::delay(3);
+                log.emplace_back("low unlock " + std::to_string(os::ticks()));
+                mutex.give();
+                log.emplace_back("low done " + std::to_string(os::ticks()));
+                os::this_task::suspend();
+            }));
+            tasks.emplace_back(createTask("high", 2, [&] () {
+                os::delay(1);
+                mutex.take();
+                log.emplace_back("high locked " + std::to_string(os::ticks()));
+                mutex.give();
+                os::this_task::suspend();
+            }));
+        });
+        runner.wait(10);
+        std::vector<std::string> expected = { "low locked 0", "low unlock 3", "high locked 3", "low done 3" };
+        expectTrue(log == expected, "log");
+    }
+
+    CASE("recursive mutex") {
+        os::RecursiveMutex mutex;
+        expectTrue(mutex.take(0), "take");
+        expectTrue(mutex.take(0), "take again");
+        expectTrue(mutex.give(), "give");
+        expectTrue(mutex.give(), "give");
+        expectFalse(mutex.give(), "give unlocked");
+    }
+
+    CASE("suspend and resume") {
+        std::vector<std::string> log;
+        os::TaskHandle handle = -1;
+        TaskRunner runner([&] (std::vector<std::unique_ptr<os::Task<1024>>> &tasks) {
+            tasks.emplace_back(createTask("suspended", 1, [&] () {
+                handle = os::this_task::handle();
+                log.emplace_back("suspend " + std::to_string(os::ticks()));
+                os::this_task::suspend();
+                log.emplace_back("resumed " + std::to_string(os::ticks()));
+                os::this_task::suspend();
+            }));
+            tasks.emplace_back(createTask("resumer", 0, [&] () {
+                os::delay(2);
+                os::resume(handle);
+                os::this_task::suspend();
+            }));
+        });
+        runner.wait(5);
+        std::vector<std::string> expected = { "suspend 0", "resumed 2" };
+        expectTrue(log == expected, "log");
+    }
+
+    CASE("periodic task") {
+        int count = 0;
+        std::unique_ptr<os::PeriodicTask<1024>> task;
+        sim::Simulator simulator(sim::Target {
+            [&] () { task.reset(new os::PeriodicTask<1024>("periodic", 1, os::time::ms(10), [&] () { ++count; })); },
+            [&] () { task.reset(); },
+            [] () {}
+        });
+        simulator.setThreadedTasks(true);
+        simulator.wait(100);
+        expectEqual(count, 10, "count");
+    }
+
+    CASE("periodic task without threads") {
+        int count = 0;
+        std::unique_ptr<os::PeriodicTask<1024>> task;
+        sim::Simulator simulator(sim::Target {
+            [&] () { task.reset(new os::PeriodicTask<1024>("periodic", 1, os::time::ms(10), [&] () { ++count; })); },
+            [&] () { task.reset(); },
+            [] () {}
+        });
+        simulator.wait(100);
+        expectEqual(count, 10, "count");
+    }
+
+    CASE("blocked tasks are destroyed") {
+        os::Queue<int, 1> queue;
+        bool destroyed = false;
+        struct Guard {
+            bool &destroyed;
+            ~Guard() { destroyed = true; }
+        };
+        {
+            TaskRunner runner([&] (std::vector<std::unique_ptr<os::Task<1024>>> &tasks) {
+                tasks.emplace_back(createTask("blocked", 1, [&] () {
+                    Guard guard { destroyed };
+                    queue.receive();
+                }));
+            });
+            runner.wait(2);
+        }
+        expectTrue(destroyed, "stack unwound");
+    }
+
+}
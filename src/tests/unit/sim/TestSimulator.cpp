@@ -0,0 +1,204 @@
+#include "UnitTest.h"
+
+#include "sim/Simulator.h"
+
+#include "drivers/ButtonLedMatrix.h"
+#include "drivers/ClockTimer.h"
+#include "drivers/Lcd.h"
+#include "drivers/Midi.h"
+
+#include <memory>
+#include <vector>
+
+#include <cstdint>
+
+static sim::Target emptyTarget() {
+    return sim::Target { [] () {}, [] () {}, [] () {} };
+}
+
+struct TimerListener : public ClockTimer::Listener {
+    TimerListener(ClockTimer &timer, std::vector<uint64_t> &ticks) : timer(timer), ticks(ticks) {}
+
+    void onClockTimerTick() override {
+        ticks.emplace_back(timer.timeUs());
+    }
+
+    ClockTimer &timer;
+    std::vector<uint64_t> &ticks;
+};
+
+struct LedWriteCounter : public sim::TargetOutputHandler {
+    void writeLed(int index, bool red, bool green) override {
+        ++writes;
+    }
+
+    int writes = 0;
+};
+
+struct MidiOutputRecorder : public sim::TargetOutputHandler {
+    MidiOutputRecorder(sim::Simulator &simulator) : simulator(simulator) {}
+
+    void writeMidiOutput(sim::MidiEvent event) override {
+        if (event.kind != sim::MidiEvent::Message) {
+            return;
+        }
+        if (event.message.status() == MidiMessage::Tick) {
+            ticks.emplace_back(simulator.timeUs());
+        } else if (event.message.isNoteOn()) {
+            ++notes;
+        }
+    }
+
+    sim::Simulator &simulator;
+    std::vector<uint64_t> ticks;
+    int notes = 0;
+};
+
+UNIT_TEST("Simulator") {
+
+    CASE("updates run at the update interval") {
+        std::vector<uint64_t> updates;
+        sim::Simulator simulator(emptyTarget());
+        simulator.setUpdateInterval(250);
+        simulator.addUpdateCallback([&] () { updates.emplace_back(simulator.timeUs()); });
+        simulator.wait(1);
+        std::vector<uint64_t> expected = { 0, 250, 500, 750 };
+        expectTrue(updates == expected, "updates");
+        expectEqual(simulator.timeUs(), uint64_t(1000), "time");
+        expectEqual(simulator.ticks(), 1.0, "ticks");
+    }
+
+    CASE("timers fire at their exact time") {
+        std::vector<uint64_t> timers;
+        sim::Simulator simulator(emptyTarget());
+        auto record = [&] () { timers.emplace_back(simulator.timeUs()); };
+        simulator.scheduleTimer(1700, record);
+        simulator.scheduleTimer(30, record);
+        simulator.scheduleTimer(999, record);
+        simulator.scheduleTimer(1000, record);
+        simulator.wait(1);
+        std::vector<uint64_t> expected = { 30, 999, 1000 };
+        expectTrue(timers == expected, "before 1ms");
+        simulator.wait(1);
+        expected.emplace_back(1700);
+        expectTrue(timers == expected, "before 2ms");
+    }
+
+    CASE("clock timer ticks at its period") {
+        std::vector<uint64_t> ticks;
+        std::unique_ptr<ClockTimer> timer;
+        std::unique_ptr<TimerListener> listener;
+        sim::Simulator simulator(sim::Target {
+            [&] () {
+                timer.reset(new ClockTimer());
+                listener.reset(new TimerListener(*timer, ticks));
+                timer->setListener(listener.get());
+                timer->setPeriod(300);
+                timer->enable();
+            },
+            [&] () { listener.reset(); timer.reset(); },
+            [] () {}
+        });
+        simulator.wait(1);
+        std::vector<uint64_t> expected = { 300, 600, 900 };
+        expectTrue(ticks == expected, "ticks");
+
+        // a new period applies to the running interval, the overdue tick fires immediately
+        timer->setPeriod(50);
+        simulator.wait(1);
+        for (uint64_t time = 1000; time <= 2000; time += 50) {
+            expected.emplace_back(time);
+        }
+        expectTrue(ticks == expected, "ticks after period change");
+
+        timer->disable();
+        simulator.wait(1);
+        expectEqual(ticks.size(), expected.size(), "disabled");
+    }
+
+    CASE("lcd only sends changed rows") {
+        sim::Simulator simulator(emptyTarget());
+        Lcd lcd(simulator);
+        const uint32_t rowBytes = Lcd::Width / 2;
+        std::vector<uint8_t> frameBuffer(rowBytes * Lcd::Height, 0);
+
+        lcd.draw(frameBuffer.data());
+        expectEqual(lcd.bytesSent(), 7 + Lcd::Height * rowBytes, "initial frame");
+
+        lcd.draw(frameBuffer.data());
+        expectEqual(lcd.bytesSent(), 7 + Lcd::Height * rowBytes, "unchanged frame");
+
+        frameBuffer[3 * rowBytes] = 0xf0;
+        frameBuffer[4 * rowBytes + 10] = 0x0f;
+        frameBuffer[10 * rowBytes + 20] = 0xff;
+        lcd.draw(frameBuffer.data());
+        expectEqual(lcd.bytesSent(), 7 + Lcd::Height * rowBytes + (7 + 2 * rowBytes) + (7 + rowBytes), "changed rows");
+
+        const auto &state = simulator.targetState().lcd.state;
+        expectEqual(int(state[3 * Lcd::Width]), 0xf, "unpacked high nibble");
+        expectEqual(int(state[3 * Lcd::Width + 1]), 0, "unpacked high nibble");
+        expectEqual(int(state[4 * Lcd::Width + 20]), 0, "unpacked low nibble");
+        expectEqual(int(state[4 * Lcd::Width + 21]), 0xf, "unpacked low nibble");
+    }
+
+    CASE("button led matrix only writes changed leds") {
+        sim::Simulator simulator(emptyTarget());
+        LedWriteCounter counter;
+        simulator.registerTargetOutputObserver(&counter);
+        ButtonLedMatrix blm(simulator);
+        std::array<std::pair<uint8_t, uint8_t>, ButtonLedMatrix::Rows * ButtonLedMatrix::ColsLed> leds;
+
+        leds.fill({ 0, 0 });
+        blm.setLeds(leds);
+        expectEqual(counter.writes, int(leds.size()), "initial leds");
+
+        blm.setLeds(leds);
+        expectEqual(counter.writes, int(leds.size()), "unchanged leds");
+
+        leds[3] = { 0xff, 0 };
+        leds[7] = { 0, 0x80 };
+        blm.setLeds(leds);
+        expectEqual(counter.writes, int(leds.size()) + 2, "changed leds");
+        expectTrue(simulator.targetState().led.state[3 * 2], "red on");
+        expectTrue(simulator.targetState().led.state[7 * 2 + 1], "green on");
+
+        leds[3] = { 0x10, 0 };
+        blm.setLeds(leds);
+        expectEqual(counter.writes, int(leds.size()) + 2, "same on/off state");
+    }
+
+    CASE("midi clock ticks are sent ahead of queued messages") {
+        sim::Simulator simulator(emptyTarget());
+        MidiOutputRecorder recorder(simulator);
+        simulator.registerTargetOutputObserver(&recorder);
+        Midi midi(simulator);
+
+        // bursts of 8 notes every 10ms keep the 31250 baud output saturated
+        const int Bursts = 20;
+        const int BurstNotes = 8;
+        std::vector<uint64_t> tickTimes;
+        for (int burst = 0; burst < Bursts; ++burst) {
+            simulator.scheduleTimer(burst * 10000, [&] () {
+                for (int note = 0; note < BurstNotes; ++note) {
+                    midi.send(MidiMessage::makeNoteOn(0, 60 + note, 100));
+                }
+            });
+        }
+        for (int tick = 0; tick < Bursts * 2; ++tick) {
+            uint64_t time = tick * 5000 + 130;
+            tickTimes.emplace_back(time);
+            simulator.scheduleTimer(time, [&] () { midi.sendRealTime(MidiMessage::Tick); });
+        }
+        simulator.wait(Bursts * 10 + 10);
+
+        expectEqual(recorder.notes, Bursts * BurstNotes, "all notes sent");
+        expectEqual(recorder.ticks.size(), tickTimes.size(), "all ticks sent");
+        uint64_t maxDelay = 0;
+        for (size_t i = 0; i < std::min(recorder.ticks.size(), tickTimes.size()); ++i) {
+            maxDelay = std::max(maxDelay, recorder.ticks[i] - tickTimes[i]);
+        }
+        // a tick waits at most for the byte currently on the wire
+        expectTrue(maxDelay <= 2 * Midi::ByteTimeUs, "tick jitter");
+    }
+
+}